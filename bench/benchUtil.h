@@ -0,0 +1,79 @@
+#pragma once
+
+// Synthetic inputs and timing shared by the benchmarks and the regression test
+
+#include "../include/Bitmap.h"
+#include "../include/Color_Space.h"
+#include "../include/picture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+// Writes scanline y of a smooth photo-like gradient into row, channels 3 (RGB)
+// or 4 (RGBA, opaque). scale stretches the gradient: 1 turns over every few
+// dozen pixels like a shrunk photo, 10 like a full-size one. Every channel gets
+// per-pixel noise of up to +-noise, so encoders don't see an unrealistically
+// flat image. A row only depends on y, so rows can be made in any order.
+inline void writeSyntheticRow(uchar* row, int y, int width, int channels, float scale, int noise)
+{
+    unsigned seed = (y + 1) * 2654435761u;
+
+    for (int x = 0; x < width; ++x, row += channels) {
+        int n = 0;
+        if (noise > 0) {
+            seed = seed * 1664525u + 1013904223u;
+            n = static_cast<int>((seed >> 16) % (2 * noise + 1)) - noise;
+        }
+
+        float const r = 127 + 100 * std::sin(x / (23 * scale)) + 20 * std::cos(y / (7 * scale));
+        float const g = 120 + 90 * std::cos((x + y) / (31 * scale));
+        float const b = 128 + 100 * std::sin(y / (18 * scale)) * std::cos(x / (40 * scale));
+
+        row[0] = clrspc::clamp_channel(r + n);
+        row[1] = clrspc::clamp_channel(g + n);
+        row[2] = clrspc::clamp_channel(b + n);
+        if (channels == 4)
+            row[3] = 255;
+    }
+}
+
+inline Picture makeSyntheticPicture(int width, int height, float scale, int noise)
+{
+    Picture pic(width, height);
+
+    for (int y = 0; y < height; ++y) {
+        writeSyntheticRow(&pic._values[4 * static_cast<size_t>(y) * width], y, width, 4, scale,
+            noise);
+    }
+
+    return pic;
+}
+
+inline Bitmap makeSyntheticBitmap(int width, int height, float scale, int noise)
+{
+    Bitmap bitmap(width, height);
+
+    for (int y = 0; y < height; ++y) {
+        writeSyntheticRow(&bitmap.m_bits[Bitmap::CHANNELS * static_cast<size_t>(y) * width], y,
+            width, Bitmap::CHANNELS, scale, noise);
+    }
+
+    return bitmap;
+}
+
+// fastest of repeats runs of func, in milliseconds
+template<typename Func> double bestOfMs(int repeats, Func&& func)
+{
+    double best = std::numeric_limits<double>::max();
+
+    for (int r = 0; r < repeats; ++r) {
+        auto const start = std::chrono::steady_clock::now();
+        func();
+        auto const end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    return best;
+}
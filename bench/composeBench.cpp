@@ -0,0 +1,72 @@
+// Scanline throughput of the tile compositor for each resource pack size.
+// 8, 16, 32 and 64 run specialized kernels, 24 the generic fallback.
+// Run from the repository root so the textures in ./blocks can be found.
+
+#include "benchUtil.h"
+#include "../include/Bitmap.h"
+#include "../include/mosaicConfig.h"
+#include "../include/texturePic.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+constexpr int REPEATS = 5;
+constexpr int OUT_WIDTH = 4096;
+constexpr int OUT_HEIGHT = 3072;
+
+// random tiles, so rows come from all over the texture set like in a real mosaic
+std::vector<std::vector<int>> makeLookupTable(int blocksX, int blocksY, int numTextures)
+{
+    std::vector<std::vector<int>> lookupTable(blocksY, std::vector<int>(blocksX));
+    unsigned seed = 1;
+
+    for (auto& row : lookupTable) {
+        for (int& texIdx : row) {
+            seed = seed * 1664525u + 1013904223u;
+            texIdx = (seed >> 8) % numTextures;
+        }
+    }
+
+    return lookupTable;
+}
+
+double composeMs(ScanlineSource const& source, int channels)
+{
+    std::vector<uchar> row(channels * OUT_WIDTH);
+
+    return bestOfMs(REPEATS, [&] {
+        for (int y = 0; y < OUT_HEIGHT; ++y) {
+            source(y, row.data());
+        }
+    });
+}
+
+int main()
+{
+    std::printf("| %-5s | %-8s | %9s | %8s |\n", "tile", "channels", "ms", "MP/s");
+    std::printf("|%s|%s|%s|%s|\n", std::string(7, '-').c_str(), std::string(10, '-').c_str(),
+        std::string(11, '-').c_str(), std::string(10, '-').c_str());
+
+    double const megaPixels = OUT_WIDTH * static_cast<double>(OUT_HEIGHT) / 1e6;
+
+    for (int blockSize : { 8, 16, 24, 32, 64 }) {
+        MosaicConfig config;
+        config.blockSize = blockSize;
+
+        std::vector<Bitmap> validTextures;
+        std::vector<clrspc::Lab> textureAvgColors;
+        getTextureData(validTextures, textureAvgColors, config);
+
+        auto const lookupTable = makeLookupTable(
+            OUT_WIDTH / blockSize, OUT_HEIGHT / blockSize, validTextures.size());
+
+        for (int channels : { 3, 4 }) {
+            double const ms = composeMs(
+                texturedScanlines(lookupTable, validTextures, channels, blockSize), channels);
+            std::printf("| %2dx%-2d | %-8s | %9.2f | %8.1f |\n", blockSize, blockSize,
+                channels == 3 ? "RGB" : "RGBA", ms, megaPixels / (ms / 1000));
+        }
+    }
+}
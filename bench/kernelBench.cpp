@@ -0,0 +1,349 @@
+// Throughput of every pipeline kernel on synthetic 1, 12 and 48 megapixel
+// images, in the spirit of Google Benchmark: each case repeats its body until
+// a repetition has run for at least --min-time seconds, and the best of
+// --repetitions repetitions is reported in pixels per second.
+//
+// findClosestColorIdx and buildLookupTable work on the image scaled down by
+// BLOCK_SIZE, like in the real pipeline, and count those pixels.
+// createTexturedPic counts the pixels of the mosaic it writes.
+//
+//   kernelBench [--filter <text>] [--sizes 1,12,48] [--min-time <s>]
+//               [--repetitions <n>] [--json <file>] [--baseline <file>]
+//
+// --baseline takes the --json output of an earlier run, e.g. of another build
+// variant, and adds the speedup over it to every row.
+//
+// Run from the repository root so the textures in ./blocks can be found.
+
+#include "benchUtil.h"
+#include "../include/Bitmap.h"
+#include "../include/colorHistogram.h"
+#include "../include/picture.h"
+#include "../include/texturePic.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ImageSize {
+    int megaPixels;
+    int width;
+    int height;
+};
+
+// 4:3, like most camera output
+constexpr ImageSize IMAGE_SIZES[] = { { 1, 1152, 864 }, { 12, 4000, 3000 }, { 48, 8000, 6000 } };
+
+struct Options {
+    std::string filter;
+    std::vector<int> sizes = { 1, 12, 48 };
+    double minTimeS = 0.5;
+    int repetitions = 3;
+    std::string jsonPath;
+    std::string baselinePath;
+};
+
+struct Result {
+    std::string name;
+    double pixels;
+    long iterations;
+    double bestMs;
+    double meanMs;
+};
+
+// keeps results alive so the compiler cannot drop the work producing them
+template<typename T> void doNotOptimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class Runner {
+public:
+    Runner(Options const& options, std::map<std::string, double> const& baselineMs)
+        : m_options(options)
+        , m_baselineMs(baselineMs)
+    {
+    }
+
+    bool wants(std::string const& name) const
+    {
+        return name.find(m_options.filter) != std::string::npos;
+    }
+
+    // body processes pixels pixels per call
+    void run(std::string const& name, double pixels, std::function<void()> const& body)
+    {
+        if (!wants(name))
+            return;
+
+        using Clock = std::chrono::steady_clock;
+        auto timeMs = [&](long iterations) {
+            auto const start = Clock::now();
+            for (long i = 0; i < iterations; ++i) {
+                body();
+            }
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        };
+
+        // the first call warms caches and sizes the repetitions
+        double const firstMs = std::max(timeMs(1), 1e-6);
+        long const iterations
+            = std::clamp<long>(std::ceil(m_options.minTimeS * 1e3 / firstMs), 1, 1'000'000);
+
+        Result result { name, pixels, iterations, std::numeric_limits<double>::max(), 0 };
+        for (int r = 0; r < m_options.repetitions; ++r) {
+            double const msPerIteration = timeMs(iterations) / iterations;
+            result.bestMs = std::min(result.bestMs, msPerIteration);
+            result.meanMs += msPerIteration / m_options.repetitions;
+        }
+
+        std::printf("| %-30s | %10ld | %12.3f | %12.3f | %9.2f |", name.c_str(), iterations,
+            result.bestMs, result.meanMs, pixels / result.bestMs / 1e3);
+        if (!m_baselineMs.empty()) {
+            auto const baseline = m_baselineMs.find(name);
+            if (baseline != m_baselineMs.end()) {
+                std::printf(" %7.2fx |", baseline->second / result.bestMs);
+            } else {
+                std::printf(" %8s |", "-");
+            }
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+        m_results.push_back(result);
+    }
+
+    std::vector<Result> const& results() const { return m_results; }
+
+private:
+    Options m_options;
+    std::map<std::string, double> m_baselineMs;
+    std::vector<Result> m_results;
+};
+
+void benchSize(Runner& runner, ImageSize const& size, std::vector<Bitmap> const& validTextures,
+    std::vector<clrspc::Lab> const& textureAvgColors)
+{
+    std::string const suffix = "/" + std::to_string(size.megaPixels) + "MP";
+    double const pixels = static_cast<double>(size.width) * size.height;
+    std::string const outPath = "./bench_output.png";
+
+    Picture const pic = makeSyntheticPicture(size.width, size.height, 10, 8);
+    Bitmap const blocks = pic.bilinearResize(1.f / BLOCK_SIZE).getBitmap();
+    double const blockPixels = static_cast<double>(blocks.m_width) * blocks.m_height;
+
+    if (runner.wants("Rgb::to_lab" + suffix)) {
+        Bitmap const bitmap = pic.getBitmap();
+        runner.run("Rgb::to_lab" + suffix, pixels, [&] {
+            float sum = 0;
+            for (int y = 0; y < bitmap.m_height; ++y) {
+                for (int x = 0; x < bitmap.m_width; ++x) {
+                    sum += bitmap.get(x, y).to_lab().l();
+                }
+            }
+            doNotOptimize(sum);
+        });
+    }
+
+    std::vector<clrspc::Lab> blockLabs;
+    for (int y = 0; y < blocks.m_height; ++y) {
+        for (int x = 0; x < blocks.m_width; ++x) {
+            blockLabs.push_back(blocks.get(x, y).to_lab());
+        }
+    }
+
+    runner.run("findClosestColorIdx" + suffix, blockPixels, [&] {
+        size_t sum = 0;
+        for (clrspc::Lab const& lab : blockLabs) {
+            sum += findClosestColorIdx(lab, textureAvgColors);
+        }
+        doNotOptimize(sum);
+    });
+
+    runner.run("buildLookupTable" + suffix, blockPixels,
+        [&] { doNotOptimize(buildLookupTable(blocks, textureAvgColors).size()); });
+
+    if (runner.wants("buildColorHistogram" + suffix) || runner.wants("findDistinctColors" + suffix)) {
+        Bitmap const bitmap = pic.getBitmap();
+        runner.run("buildColorHistogram" + suffix, pixels,
+            [&] { doNotOptimize(buildColorHistogram(bitmap).size()); });
+        runner.run("findDistinctColors" + suffix, pixels,
+            [&] { doNotOptimize(findDistinctColors(bitmap).colors.size()); });
+    }
+
+    for (int const radius : { 3, 9, 25 }) {
+        std::string const name = "gaussianBlur/r" + std::to_string(radius) + suffix;
+        if (!runner.wants(name))
+            continue;
+
+        // blurring in place again costs the same, so one copy is enough
+        Picture blurred = pic;
+        runner.run(name, pixels, [&] { blurred.gaussianBlur(radius); });
+    }
+
+    runner.run("bilinearResize" + suffix, pixels,
+        [&] { doNotOptimize(pic.bilinearResize(1.f / BLOCK_SIZE).width()); });
+
+    auto const lookupTable = buildLookupTable(blocks, textureAvgColors);
+    double const mosaicPixels = blockPixels * BLOCK_SIZE * BLOCK_SIZE;
+    runner.run("createTexturedPic" + suffix, mosaicPixels, [&] {
+        createTexturedPic(lookupTable, validTextures, outPath, OutputFormat::Png, BLOCK_SIZE);
+    });
+
+    runner.run("Picture::save" + suffix, pixels, [&] { pic.save(outPath); });
+
+    std::filesystem::remove(outPath);
+}
+
+void writeJsonResults(std::ostream& os, Options const& options, std::vector<Result> const& results)
+{
+    char date[32];
+    std::time_t const now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n  \"context\": {\"date\": \"" << date
+       << "\", \"num_cpus\": " << std::thread::hardware_concurrency()
+       << ", \"min_time_s\": " << options.minTimeS
+       << ", \"repetitions\": " << options.repetitions << "},\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        Result const& result = results[i];
+        os << (i ? ",\n" : "\n") << "    {\"name\": \"" << result.name
+           << "\", \"iterations\": " << result.iterations
+           << ", \"real_time\": " << result.bestMs
+           << ", \"mean_real_time\": " << result.meanMs << ", \"time_unit\": \"ms\""
+           << ", \"pixels\": " << static_cast<long long>(result.pixels)
+           << ", \"pixels_per_second\": " << result.pixels / result.bestMs * 1e3 << "}";
+    }
+
+    os << "\n  ]\n}\n";
+}
+
+// best time per benchmark name from a file written by writeJsonResults, which
+// puts every benchmark on its own line
+std::map<std::string, double> readBaseline(std::string const& path)
+{
+    std::ifstream ifs(path);
+    if (!ifs)
+        throw std::runtime_error("failed to open baseline: " + path);
+
+    static std::regex const entry(R"re("name": "([^"]+)".*"real_time": ([^,]+),)re");
+    std::map<std::string, double> baselineMs;
+    std::string line;
+    std::smatch match;
+
+    while (std::getline(ifs, line)) {
+        if (std::regex_search(line, match, entry)) {
+            baselineMs[match[1]] = std::stod(match[2]);
+        }
+    }
+
+    return baselineMs;
+}
+
+std::vector<int> parseSizes(std::string const& list)
+{
+    std::vector<int> sizes;
+    std::stringstream ss(list);
+    std::string item;
+
+    while (std::getline(ss, item, ',')) {
+        int const megaPixels = std::stoi(item);
+        auto const known = std::find_if(std::begin(IMAGE_SIZES), std::end(IMAGE_SIZES),
+            [&](ImageSize const& size) { return size.megaPixels == megaPixels; });
+        if (known == std::end(IMAGE_SIZES))
+            throw std::invalid_argument("unknown size: " + item + " (use 1, 12 or 48)");
+        sizes.push_back(megaPixels);
+    }
+
+    return sizes;
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string const arg = argv[i];
+        if (i + 1 >= argc)
+            throw std::invalid_argument("missing value for " + arg);
+
+        std::string const value = argv[++i];
+        if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--sizes") {
+            options.sizes = parseSizes(value);
+        } else if (arg == "--min-time") {
+            options.minTimeS = std::stod(value);
+        } else if (arg == "--repetitions") {
+            options.repetitions = std::max(1, std::stoi(value));
+        } else if (arg == "--json") {
+            options.jsonPath = value;
+        } else if (arg == "--baseline") {
+            options.baselinePath = value;
+        } else {
+            throw std::invalid_argument("unknown option: " + arg);
+        }
+    }
+
+    return options;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    std::map<std::string, double> baselineMs;
+    try {
+        options = parseOptions(argc, argv);
+        if (!options.baselinePath.empty()) {
+            baselineMs = readBaseline(options.baselinePath);
+        }
+    } catch (std::exception const& e) {
+        std::cerr << e.what()
+                  << "\nusage: kernelBench [--filter <text>] [--sizes 1,12,48] [--min-time <s>]\n"
+                     "                   [--repetitions <n>] [--json <file>] [--baseline <file>]\n";
+        return 1;
+    }
+
+    std::vector<Bitmap> validTextures;
+    std::vector<clrspc::Lab> textureAvgColors;
+    getTextureData(validTextures, textureAvgColors);
+
+    bool const hasBaseline = !baselineMs.empty();
+    std::printf("| %-30s | %10s | %12s | %12s | %9s |%s\n", "kernel", "iterations", "best ms",
+        "mean ms", "MP/s", hasBaseline ? "  speedup |" : "");
+    std::printf("|%s|%s|%s|%s|%s|%s\n", std::string(32, '-').c_str(),
+        std::string(12, '-').c_str(), std::string(14, '-').c_str(), std::string(14, '-').c_str(),
+        std::string(11, '-').c_str(), hasBaseline ? "----------|" : "");
+
+    Runner runner(options, baselineMs);
+    for (ImageSize const& size : IMAGE_SIZES) {
+        if (std::find(options.sizes.begin(), options.sizes.end(), size.megaPixels)
+            != options.sizes.end()) {
+            benchSize(runner, size, validTextures, textureAvgColors);
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream ofs(options.jsonPath);
+        writeJsonResults(ofs, options, runner.results());
+        if (!ofs) {
+            std::cerr << "failed to write " << options.jsonPath << '\n';
+            return 1;
+        }
+    }
+}
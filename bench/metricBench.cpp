@@ -0,0 +1,104 @@
+// Cost and quality of every color metric when matching to the texture palette.
+// Cost is colors matched per second on one thread. Quality is the mean CIEDE2000
+// difference between each color and the texture it's matched to, and how often
+// the match is the one exhaustive CIEDE2000 picks. CIEDE2000 also runs with
+// shortlists of several sizes, which shows what the OkLab prefilter costs.
+// Run from the repository root so the textures in ./blocks can be found.
+
+#include "benchUtil.h"
+#include "../include/Color_Space.h"
+#include "../include/colorMetric.h"
+#include "../include/texturePic.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+constexpr int NUM_COLORS = 100000;
+constexpr int REPEATS = 3;
+
+// uniform over the RGB cube, so every region of the palette gets matched
+std::vector<clrspc::Lab> makeColors()
+{
+    std::vector<clrspc::Lab> colors;
+    unsigned seed = 1;
+
+    for (int i = 0; i < NUM_COLORS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        colors.push_back(clrspc::Rgb(seed >> 24, (seed >> 16) & 0xFF, (seed >> 8) & 0xFF).to_lab());
+    }
+
+    return colors;
+}
+
+struct Case {
+    char const* name;
+    ColorMetric metric;
+    int candidates;
+};
+
+int main()
+{
+    std::vector<Bitmap> validTextures;
+    std::vector<clrspc::Lab> textureAvgColors;
+    getTextureData(validTextures, textureAvgColors);
+
+    std::vector<clrspc::Lab> const colors = makeColors();
+
+    // CIELAB of the colors and the palette, and the exhaustive CIEDE2000 match
+    std::vector<std::array<float, 3>> colorLabs;
+    for (clrspc::Lab const& color : colors) {
+        colorLabs.push_back(toCieLab(color));
+    }
+    std::vector<std::array<float, 3>> paletteLabs;
+    for (clrspc::Lab const& color : textureAvgColors) {
+        paletteLabs.push_back(toCieLab(color));
+    }
+    ColorMatcher const reference(textureAvgColors, ColorMetric::Ciede2000, 0);
+    std::vector<size_t> referenceMatches;
+    for (clrspc::Lab const& color : colors) {
+        referenceMatches.push_back(reference.closest(color));
+    }
+
+    Case const cases[] = {
+        { "oklab", ColorMetric::OkLab, 0 },
+        { "weighted_oklab", ColorMetric::WeightedOkLab, 0 },
+        { "cam16_ucs", ColorMetric::Cam16Ucs, 0 },
+        { "ciede2000", ColorMetric::Ciede2000, 4 },
+        { "ciede2000", ColorMetric::Ciede2000, METRIC_CANDIDATES },
+        { "ciede2000", ColorMetric::Ciede2000, 32 },
+        { "ciede2000", ColorMetric::Ciede2000, 0 },
+    };
+
+    std::printf("palette of %zu textures, %d colors\n\n", textureAvgColors.size(), NUM_COLORS);
+    std::printf("| %-16s | %10s | %9s | %10s | %12s | %14s |\n", "metric", "candidates", "ms",
+        "Mcolors/s", "mean dE2000", "same as exact");
+    std::printf("|%s|%s|%s|%s|%s|%s|\n", std::string(18, '-').c_str(),
+        std::string(12, '-').c_str(), std::string(11, '-').c_str(), std::string(12, '-').c_str(),
+        std::string(14, '-').c_str(), std::string(16, '-').c_str());
+
+    for (Case const& c : cases) {
+        ColorMatcher const matcher(textureAvgColors, c.metric, c.candidates);
+        std::vector<size_t> matches(colors.size());
+        double const best = bestOfMs(REPEATS, [&] {
+            for (size_t i = 0; i < colors.size(); ++i) {
+                matches[i] = matcher.closest(colors[i]);
+            }
+        });
+
+        double error = 0;
+        size_t same = 0;
+        for (size_t i = 0; i < colors.size(); ++i) {
+            error += ciede2000(colorLabs[i], paletteLabs[matches[i]]);
+            same += matches[i] == referenceMatches[i];
+        }
+
+        std::string const candidates = c.metric != ColorMetric::Ciede2000 ? "-"
+            : c.candidates > 0                                           ? std::to_string(c.candidates)
+                                                                         : "all";
+        std::printf("| %-16s | %10s | %9.2f | %10.2f | %12.3f | %13.2f%% |\n", c.name,
+            candidates.c_str(), best, colors.size() / best / 1e3, error / colors.size(),
+            100.0 * same / colors.size());
+    }
+}
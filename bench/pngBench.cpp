@@ -0,0 +1,58 @@
+// Encode time versus output size for each PngProfile on typical outputs.
+// Run from the repository root so the textures in ./blocks can be found.
+
+#include "benchUtil.h"
+#include "../include/Bitmap.h"
+#include "../include/picture.h"
+#include "../include/texturePic.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+constexpr int REPEATS = 3;
+
+void benchProfiles(std::string const& name, Picture const& pic)
+{
+    std::string const path = "./bench_output.png";
+    char const* profileNames[] = { "Fastest", "Balanced", "Smallest" };
+
+    for (int p = 0; p < 3; ++p) {
+        double const best
+            = bestOfMs(REPEATS, [&] { pic.save(path, static_cast<PngProfile>(p)); });
+
+        double const megaPixels = pic.width() * static_cast<double>(pic.height()) / 1e6;
+        auto const bytes = std::filesystem::file_size(path);
+
+        std::printf("| %-26s | %-8s | %9.1f | %8.1f | %10.2f |\n", name.c_str(), profileNames[p],
+            best, megaPixels / (best / 1000), bytes / 1e6);
+    }
+
+    std::filesystem::remove(path);
+}
+
+int main()
+{
+    std::vector<Bitmap> validTextures;
+    std::vector<clrspc::Lab> textureAvgColors;
+    getTextureData(validTextures, textureAvgColors);
+
+    std::printf("| %-26s | %-8s | %9s | %8s | %10s |\n", "image", "profile", "ms", "MP/s", "MB");
+    std::printf("|%s|%s|%s|%s|%s|\n", std::string(28, '-').c_str(), std::string(10, '-').c_str(),
+        std::string(11, '-').c_str(), std::string(10, '-').c_str(), std::string(12, '-').c_str());
+
+    for (auto [blocksX, blocksY] : { std::pair { 128, 96 }, std::pair { 256, 192 } }) {
+        // the kind of smooth photo the mosaic is built from, one pixel per block
+        Bitmap const bitmap = makeSyntheticBitmap(blocksX, blocksY, 1, 0);
+        std::string const size = std::to_string(blocksX * BLOCK_SIZE) + "x"
+            + std::to_string(blocksY * BLOCK_SIZE);
+
+        auto const lookupTable = buildLookupTable(bitmap, textureAvgColors);
+        benchProfiles("textured " + size, composeTexturedPic(lookupTable, validTextures));
+        benchProfiles("flat blocks " + size, Picture(bitmap, BLOCK_SIZE));
+    }
+}
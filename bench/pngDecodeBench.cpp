@@ -0,0 +1,61 @@
+// Decode time of the fused decoder against the previous lodepng::decode call.
+
+#include "benchUtil.h"
+#include "../include/Bitmap.h"
+#include "../include/lodepng.h"
+#include "../include/pngDecoder.h"
+#include "../include/pngEncoder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+constexpr int REPEATS = 3;
+
+void printRow(std::string const& image, char const* method, double ms, double megaPixels)
+{
+    std::printf("| %-10s | %-34s | %9.1f | %8.1f |\n", image.c_str(), method, ms,
+        megaPixels / (ms / 1000));
+}
+
+int main()
+{
+    std::string const path = "./bench_decode.png";
+
+    std::printf("| %-10s | %-34s | %9s | %8s |\n", "image", "decoder", "ms", "MP/s");
+    std::printf("|%s|%s|%s|%s|\n", std::string(12, '-').c_str(), std::string(36, '-').c_str(),
+        std::string(11, '-').c_str(), std::string(10, '-').c_str());
+
+    for (auto [width, height] : { std::pair { 1152, 864 }, std::pair { 4000, 3000 } }) {
+        // photo-like content with some noise so the file doesn't compress to nothing
+        encodePng(path, width, height, PngColorType::Rgb,
+            [&](int y, uchar* row) { writeSyntheticRow(row, y, width, 3, 10, 4); });
+        double const megaPixels = width * static_cast<double>(height) / 1e6;
+        std::string const image = std::to_string(width) + "x" + std::to_string(height);
+
+        printRow(image, "lodepng::decode RGBA + to Bitmap", bestOfMs(REPEATS, [&] {
+            std::vector<uchar> rgba;
+            unsigned w, h;
+            lodepng::decode(rgba, w, h, path);
+            Bitmap bitmap(w, h);
+            for (size_t i = 0, j = 0; i < rgba.size(); i += 4, j += 3) {
+                std::memcpy(&bitmap.m_bits[j], &rgba[i], 3);
+            }
+        }),
+            megaPixels);
+
+        printRow(image, "decodePng RGBA", bestOfMs(REPEATS, [&] {
+            std::vector<uchar> rgba;
+            int w, h;
+            decodePng(path, rgba, w, h, 4);
+        }),
+            megaPixels);
+
+        printRow(image, "decodePngBitmap", bestOfMs(REPEATS, [&] { decodePngBitmap(path); }), megaPixels);
+    }
+
+    std::filesystem::remove(path);
+}
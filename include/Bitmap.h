@@ -2,10 +2,18 @@
 
 #include "Color_Space.h"
 
+#include <cstdint>
 #include <cstring>
 
 using uchar = std::uint8_t;
 
+// the fourth byte of a pixel loaded as a native-endian 32-bit word
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr uint32_t ALPHA_MASK = 0x000000ffu;
+#else
+constexpr uint32_t ALPHA_MASK = 0xff000000u;
+#endif
+
 class Bitmap {
 public:
   static const int CHANNELS = 3;
@@ -26,21 +34,35 @@ public:
     const uchar g = m_bits[CHANNELS * (y * m_width + x) + 1];
     const uchar b = m_bits[CHANNELS * (y * m_width + x) + 2];
 
-    return clrspc::Rgb(r, g, b);
+    return clrspc::Rgb::from_bytes(r, g, b);
   }
 
-  std::array<uchar, 64> getSixteen(int x, int y) const {
-    std::array<uchar, 64> outArr;
+  // expands count pixels of row y, starting at x, to RGBA in out. Each pixel
+  // is moved as one 32-bit word with the byte after it forced to 255, the
+  // last one byte by byte so the read never runs past the row
+  void getRgbaRow(int x, int y, int count, uchar *out) const {
+    const uchar *in = &m_bits[CHANNELS * (y * m_width + x)];
+
+    for (int i = 0; i < count - 1; ++i) {
+      uint32_t pixel;
+      std::memcpy(&pixel, &in[i * CHANNELS], 4);
+      pixel |= ALPHA_MASK;
+      std::memcpy(&out[i * 4], &pixel, 4);
+    }
 
-    for (int i = 0; i < 16; ++i) {
-      const int index = CHANNELS * (y * m_width + x + i);
-      outArr[i * 4 + 0] = m_bits[index + 0]; // R
-      outArr[i * 4 + 1] = m_bits[index + 1]; // G
-      outArr[i * 4 + 2] = m_bits[index + 2]; // B
-      outArr[i * 4 + 3] = 255;               // A
+    if (count > 0) {
+      const int last = count - 1;
+      out[last * 4 + 0] = in[last * CHANNELS + 0]; // R
+      out[last * 4 + 1] = in[last * CHANNELS + 1]; // G
+      out[last * 4 + 2] = in[last * CHANNELS + 2]; // B
+      out[last * 4 + 3] = 255;                     // A
     }
+  }
 
-    return outArr;
+  // same with the count known at compile time, so the loop fully unrolls for
+  // the tile sizes the compositor specializes on
+  template <int N> void getRgbaRow(int x, int y, uchar *out) const {
+    getRgbaRow(x, y, N, out);
   }
 
   int m_width;
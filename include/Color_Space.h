@@ -4,7 +4,9 @@
 #include <array>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #define _USE_MATH_DEFINES // for VS
@@ -17,16 +19,20 @@ namespace clrspc {
 class Lab;
 class Rgb;
 
+// Colors are plain values without a vtable, so arrays of them are dense and
+// can be copied and loaded as raw memory. Print them with print(color)
 template<typename T> class Color {
 protected:
     std::array<T, 3> m_values;
 
 public:
-    Color(T x, T y, T z) { m_values = { x, y, z }; }
-
-    [[nodiscard]] std::array<T, 3> get_values() const { return m_values; }
+    Color() = default;
+    constexpr Color(T x, T y, T z)
+        : m_values { x, y, z }
+    {
+    }
 
-    virtual void print() const = 0;
+    [[nodiscard]] constexpr std::array<T, 3> get_values() const { return m_values; }
 
     [[nodiscard]] bool operator==(Color const& other) const
     {
@@ -42,41 +48,694 @@ public:
 
 class Lab : public Color<float> {
 public:
-    Lab(float l, float a, float b);
-
-    float l() const { return m_values[0]; }
-    float a() const { return m_values[1]; }
-    float b() const { return m_values[2]; }
-
-    [[nodiscard]] Rgb to_rgb() const;
-
-    void print() const override;
+    Lab() = default;
+    constexpr Lab(float l, float a, float b);
+
+    constexpr float l() const { return m_values[0]; }
+    constexpr float a() const { return m_values[1]; }
+    constexpr float b() const { return m_values[2]; }
+
+    [[nodiscard]] constexpr Rgb to_rgb() const;
+    // to_rgb, with colors outside sRGB first brought onto its boundary by
+    // reducing chroma at constant lightness and hue, instead of clamping each
+    // channel, which shifts hue and lightness
+    [[nodiscard]] constexpr Rgb to_rgb_in_gamut() const;
 };
 
 class Rgb : public Color<uchar> {
 public:
-    Rgb(float r, float g, float b);
+    Rgb() = default;
+    // rounds to the nearest byte, out of range values are clamped and counted
+    // in clamp_stats()
+    constexpr Rgb(float r, float g, float b);
+
+    // for hot loops: bytes as they are
+    static constexpr Rgb from_bytes(uchar r, uchar g, uchar b);
+    // for hot loops whose values are in range by construction, such as
+    // interpolated bytes: rounds and clamps without counting
+    static constexpr Rgb unchecked(float r, float g, float b);
+
+    constexpr float r() const { return m_values[0]; }
+    constexpr float g() const { return m_values[1]; }
+    constexpr float b() const { return m_values[2]; }
+
+    [[nodiscard]] constexpr Lab to_lab() const;
+};
+
+// =========== sRGB transfer ==========
+
+// sRGB decoding of every 8 bit value, linear light in [0, 1]
+inline constexpr std::array<float, 256> SRGB_TO_LINEAR = {
+    0.0f, 0.000303526991f, 0.000607053982f, 0.000910580973f, 0.00121410796f, 0.00151763496f,
+    0.00182116195f, 0.00212468882f, 0.00242821593f, 0.0027317428f, 0.00303526991f, 0.00334653584f,
+    0.00367650739f, 0.00402471703f, 0.00439144205f, 0.00477695325f, 0.00518151652f, 0.00560539169f,
+    0.00604883302f, 0.00651209056f, 0.00699541019f, 0.00749903219f, 0.00802319311f, 0.00856812578f,
+    0.00913405884f, 0.00972121768f, 0.010329823f, 0.0109600937f, 0.0116122449f, 0.012286488f,
+    0.0129830325f, 0.0137020834f, 0.0144438436f, 0.0152085144f, 0.0159962941f, 0.0168073755f,
+    0.0176419541f, 0.01850022f, 0.0193823613f, 0.0202885624f, 0.0212190095f, 0.0221738853f,
+    0.0231533665f, 0.0241576321f, 0.0251868591f, 0.0262412224f, 0.0273208916f, 0.02842604f,
+    0.0295568351f, 0.0307134446f, 0.0318960324f, 0.0331047662f, 0.0343398079f, 0.0356013142f,
+    0.0368894488f, 0.0382043719f, 0.0395462364f, 0.0409151986f, 0.0423114114f, 0.043735031f,
+    0.045186203f, 0.0466650873f, 0.0481718257f, 0.0497065671f, 0.0512694567f, 0.0528606474f,
+    0.054480277f, 0.0561284907f, 0.0578054301f, 0.0595112368f, 0.0612460524f, 0.0630100146f,
+    0.064803265f, 0.0666259378f, 0.0684781671f, 0.0703600943f, 0.0722718537f, 0.0742135718f,
+    0.0761853829f, 0.078187421f, 0.0802198201f, 0.0822827071f, 0.0843762085f, 0.0865004584f,
+    0.0886555836f, 0.0908417106f, 0.0930589661f, 0.0953074694f, 0.097587347f, 0.0998987257f,
+    0.102241732f, 0.104616486f, 0.107023105f, 0.10946171f, 0.111932427f, 0.114435375f, 0.116970666f,
+    0.119538426f, 0.122138776f, 0.124771819f, 0.127437681f, 0.130136475f, 0.13286832f, 0.135633335f,
+    0.138431609f, 0.141263291f, 0.144128472f, 0.147027269f, 0.149959788f, 0.152926147f,
+    0.155926466f, 0.158960834f, 0.162029371f, 0.165132195f, 0.168269396f, 0.171441108f,
+    0.174647406f, 0.177888423f, 0.18116425f, 0.18447499f, 0.187820777f, 0.191201687f, 0.194617838f,
+    0.198069319f, 0.20155625f, 0.205078736f, 0.208636865f, 0.212230757f, 0.215860501f, 0.219526201f,
+    0.223227963f, 0.226965874f, 0.230740055f, 0.23455058f, 0.238397568f, 0.242281124f, 0.246201321f,
+    0.25015828f, 0.254152089f, 0.258182853f, 0.262250662f, 0.266355604f, 0.270497799f, 0.274677306f,
+    0.278894275f, 0.283148736f, 0.287440836f, 0.291770637f, 0.296138257f, 0.300543785f,
+    0.304987311f, 0.309468925f, 0.313988715f, 0.318546772f, 0.323143214f, 0.327778101f,
+    0.332451522f, 0.337163627f, 0.341914415f, 0.346704066f, 0.351532608f, 0.356400132f,
+    0.361306787f, 0.366252601f, 0.371237695f, 0.376262128f, 0.38132602f, 0.386429429f, 0.391572475f,
+    0.396755219f, 0.401977777f, 0.407240212f, 0.412542611f, 0.417885065f, 0.423267663f,
+    0.428690493f, 0.434153646f, 0.439657182f, 0.445201188f, 0.450785786f, 0.456411034f,
+    0.462076992f, 0.467783809f, 0.473531485f, 0.479320168f, 0.48514995f, 0.491020858f, 0.496932983f,
+    0.502886474f, 0.50888133f, 0.514917672f, 0.520995557f, 0.527115107f, 0.533276379f, 0.539479494f,
+    0.545724452f, 0.55201143f, 0.558340371f, 0.564711511f, 0.571124852f, 0.577580452f, 0.584078431f,
+    0.590618849f, 0.597201765f, 0.603827357f, 0.610495567f, 0.617206573f, 0.623960376f,
+    0.630757153f, 0.637596846f, 0.644479692f, 0.651405632f, 0.658374846f, 0.665387273f,
+    0.672443151f, 0.679542482f, 0.686685324f, 0.693871737f, 0.701101899f, 0.708375752f,
+    0.715693474f, 0.723055124f, 0.730460763f, 0.73791039f, 0.745404184f, 0.752942204f, 0.760524511f,
+    0.768151164f, 0.775822222f, 0.783537805f, 0.791297913f, 0.799102724f, 0.806952238f,
+    0.814846575f, 0.822785735f, 0.830769897f, 0.838799f, 0.846873224f, 0.854992628f, 0.863157213f,
+    0.871367097f, 0.8796224f, 0.887923121f, 0.896269381f, 0.904661179f, 0.913098633f, 0.921581864f,
+    0.930110872f, 0.938685715f, 0.947306514f, 0.955973327f, 0.964686275f, 0.973445296f,
+    0.982250571f, 0.991102099f, 1.0f,
+};
 
-    float r() const { return m_values[0]; }
-    float g() const { return m_values[1]; }
-    float b() const { return m_values[2]; }
+// ========== Roots ==========
 
-    [[nodiscard]] Lab to_lab() const;
+// std::cbrt, std::sqrt and std::pow are only constexpr in libstdc++, so the
+// conversions use these instead. The argument is moved into [1, 8) or [1, 4)
+// by whole cubes or squares and the root is refined there in double, within
+// 1e-13 of the exact one. Rounded to float, cube_root matches the correctly
+// rounded cube root for every color, and takes half the time of std::cbrt.
+
+constexpr double cube_root(double x)
+{
+    if (x == 0 || x != x || x - x != 0) // zero, NaN and infinities
+        return x;
+
+    double m = x < 0 ? -x : x;
+    double scale = x < 0 ? -1 : 1;
+    for (; m >= 8; m /= 8) {
+        scale *= 2;
+    }
+    for (; m < 1; m *= 8) {
+        scale /= 2;
+    }
+
+    // within 4% on [1, 8), then Halley steps, each cubing the error
+    double y = 0.81393683 + (0.23620700 - 0.011155787 * m) * m;
+    for (int i = 0; i < 2; ++i) {
+        double const y3 = y * y * y;
+        y *= (y3 + 2 * m) / (2 * y3 + m);
+    }
+    return scale * y;
+}
 
-    void print() const override;
+constexpr double square_root(double x)
+{
+    if (!(x > 0) || x - x != 0) // zero, NaN and infinity; x is never negative
+        return x;
+
+    double m = x;
+    double scale = 1;
+    for (; m >= 4; m /= 4) {
+        scale *= 2;
+    }
+    for (; m < 1; m *= 4) {
+        scale /= 2;
+    }
+
+    // within 6% on [1, 4), then Newton steps, each squaring the error
+    double y = 1 + (m - 1) / 3;
+    for (int i = 0; i < 5; ++i) {
+        y = (y + m / y) / 2;
+    }
+    return scale * y;
+}
+
+// sRGB encoding of linear light to 0-255, out of range values extrapolated.
+// c^(1 / 2.4) is taken as the cube root of c^(5 / 4)
+constexpr float srgb_encode(float c)
+{
+    if (c <= 0.0031308f)
+        return 255 * 12.92f * c;
+
+    float const root = cube_root(c * square_root(square_root(c)));
+    return 255 * (1.055f * root - 0.055f);
+}
+
+// srgb_encode at 4096 even steps of [0, 1]. Written out, since computing
+// it in a constant expression runs past the step limits of clang and MSVC
+inline constexpr std::array<float, 4097> LINEAR_TO_SRGB = {
+    0.0f, 0.8043457f, 1.6086915f, 2.4130373f, 3.217383f, 4.0217285f, 4.8260746f, 5.63042f,
+    6.434766f, 7.2391114f, 8.043457f, 8.847803f, 9.652149f, 10.45355f, 11.221199f, 11.957485f,
+    12.665661f, 13.348461f, 14.008212f, 14.646913f, 15.266291f, 15.867853f, 16.452929f, 17.02269f,
+    17.578173f, 18.120314f, 18.649948f, 19.167826f, 19.674631f, 20.170988f, 20.657457f, 21.134556f,
+    21.602758f, 22.0625f, 22.514185f, 22.958187f, 23.394848f, 23.824492f, 24.247414f, 24.663889f,
+    25.07418f, 25.478535f, 25.877172f, 26.27031f, 26.658152f, 27.040886f, 27.418688f, 27.791733f,
+    28.160177f, 28.524162f, 28.883844f, 29.239357f, 29.590822f, 29.938368f, 30.282104f, 30.622156f,
+    30.958612f, 31.291586f, 31.621168f, 31.947447f, 32.270527f, 32.59047f, 32.907375f, 33.221313f,
+    33.53235f, 33.840572f, 34.14603f, 34.448814f, 34.748962f, 35.046555f, 35.34163f, 35.634266f,
+    35.924503f, 36.212406f, 36.498005f, 36.781372f, 37.062542f, 37.34156f, 37.61847f, 37.893314f,
+    38.16615f, 38.43699f, 38.705887f, 38.97288f, 39.23801f, 39.501297f, 39.76279f, 40.022507f,
+    40.2805f, 40.53678f, 40.79138f, 41.044342f, 41.29569f, 41.545452f, 41.793644f, 42.0403f,
+    42.285454f, 42.52911f, 42.771317f, 43.01209f, 43.25144f, 43.489395f, 43.725986f, 43.961224f,
+    44.19514f, 44.427742f, 44.659058f, 44.889095f, 45.11789f, 45.34545f, 45.571796f, 45.79695f,
+    46.02092f, 46.243725f, 46.46538f, 46.685913f, 46.905323f, 47.123634f, 47.340862f, 47.55701f,
+    47.77211f, 47.986164f, 48.19919f, 48.411205f, 48.622208f, 48.832222f, 49.041256f, 49.249332f,
+    49.456444f, 49.66262f, 49.867863f, 50.072193f, 50.27561f, 50.478134f, 50.67977f, 50.88053f,
+    51.080433f, 51.279465f, 51.47766f, 51.675014f, 51.871548f, 52.06726f, 52.26217f, 52.456276f,
+    52.649586f, 52.84212f, 53.033882f, 53.224884f, 53.415115f, 53.604614f, 53.793365f, 53.981384f,
+    54.168686f, 54.355263f, 54.541126f, 54.72629f, 54.910755f, 55.094536f, 55.27764f, 55.460068f,
+    55.64181f, 55.82291f, 56.00335f, 56.183147f, 56.362293f, 56.5408f, 56.71869f, 56.89595f,
+    57.07258f, 57.24861f, 57.42403f, 57.59885f, 57.77308f, 57.946716f, 58.119766f, 58.29224f,
+    58.464134f, 58.635468f, 58.80623f, 58.976437f, 59.146084f, 59.31519f, 59.483757f, 59.651768f,
+    59.819256f, 59.986217f, 60.15264f, 60.31855f, 60.483948f, 60.648827f, 60.813198f, 60.97707f,
+    61.14043f, 61.303303f, 61.465683f, 61.62758f, 61.788994f, 61.949917f, 62.110374f, 62.27036f,
+    62.429867f, 62.58892f, 62.74751f, 62.90564f, 63.06331f, 63.220543f, 63.377316f, 63.53366f,
+    63.689552f, 63.845016f, 64.00004f, 64.15464f, 64.30881f, 64.46256f, 64.61588f, 64.76879f,
+    64.92129f, 65.07337f, 65.22505f, 65.37631f, 65.52718f, 65.67764f, 65.82772f, 65.9774f,
+    66.126686f, 66.27558f, 66.42409f, 66.57222f, 66.71997f, 66.86735f, 67.01434f, 67.16097f,
+    67.30722f, 67.45311f, 67.59863f, 67.74379f, 67.888596f, 68.03303f, 68.177124f, 68.32087f,
+    68.46424f, 68.607285f, 68.74997f, 68.89233f, 69.034325f, 69.175995f, 69.31732f, 69.45832f,
+    69.59899f, 69.73931f, 69.87932f, 70.019f, 70.15835f, 70.29738f, 70.43609f, 70.57448f, 70.71256f,
+    70.85033f, 70.98777f, 71.12491f, 71.26175f, 71.39827f, 71.53449f, 71.6704f, 71.80602f,
+    71.94134f, 72.076355f, 72.211075f, 72.345505f, 72.479645f, 72.613495f, 72.74705f, 72.88032f,
+    73.01331f, 73.146f, 73.27842f, 73.41056f, 73.54242f, 73.674f, 73.805305f, 73.93633f, 74.06709f,
+    74.197586f, 74.327805f, 74.45775f, 74.58743f, 74.71686f, 74.846016f, 74.9749f, 75.10352f,
+    75.2319f, 75.360016f, 75.48788f, 75.61547f, 75.74283f, 75.86992f, 75.996765f, 76.12336f,
+    76.24971f, 76.3758f, 76.50166f, 76.627266f, 76.75264f, 76.877754f, 77.00264f, 77.12729f,
+    77.2517f, 77.37586f, 77.49979f, 77.6235f, 77.746956f, 77.87019f, 77.993195f, 78.11597f,
+    78.23852f, 78.36083f, 78.482925f, 78.6048f, 78.726425f, 78.84785f, 78.96904f, 79.09002f,
+    79.21078f, 79.331314f, 79.45163f, 79.57174f, 79.69163f, 79.811295f, 79.93076f, 80.05001f,
+    80.16904f, 80.28787f, 80.40649f, 80.52491f, 80.643105f, 80.7611f, 80.87889f, 80.99647f,
+    81.11386f, 81.23105f, 81.348015f, 81.46479f, 81.58138f, 81.697754f, 81.813934f, 81.929924f,
+    82.045715f, 82.1613f, 82.27671f, 82.391914f, 82.506935f, 82.62176f, 82.73639f, 82.85083f,
+    82.96508f, 83.07915f, 83.19303f, 83.306725f, 83.42022f, 83.533554f, 83.64669f, 83.75964f,
+    83.87241f, 83.98501f, 84.09741f, 84.20965f, 84.32169f, 84.43356f, 84.54526f, 84.65678f,
+    84.76813f, 84.87928f, 84.99027f, 85.10109f, 85.21173f, 85.32221f, 85.4325f, 85.54263f,
+    85.652596f, 85.76238f, 85.872f, 85.98146f, 86.090744f, 86.19986f, 86.308815f, 86.4176f,
+    86.52622f, 86.63468f, 86.74297f, 86.85111f, 86.95907f, 87.06689f, 87.17453f, 87.28202f,
+    87.38934f, 87.49651f, 87.60352f, 87.71038f, 87.81708f, 87.92362f, 88.03001f, 88.13623f,
+    88.24231f, 88.34823f, 88.454f, 88.559616f, 88.66508f, 88.770386f, 88.87555f, 88.98057f,
+    89.08543f, 89.19014f, 89.29471f, 89.39912f, 89.50339f, 89.60751f, 89.71149f, 89.815315f,
+    89.919f, 90.022545f, 90.12594f, 90.22919f, 90.3323f, 90.43527f, 90.53809f, 90.64078f, 90.74332f,
+    90.845726f, 90.94798f, 91.05012f, 91.15209f, 91.253944f, 91.35565f, 91.457214f, 91.558655f,
+    91.65995f, 91.761116f, 91.862144f, 91.963036f, 92.0638f, 92.16443f, 92.264915f, 92.36528f,
+    92.4655f, 92.5656f, 92.66556f, 92.76539f, 92.86509f, 92.96465f, 93.0641f, 93.163414f,
+    93.262596f, 93.36166f, 93.46059f, 93.55939f, 93.65806f, 93.75661f, 93.85503f, 93.95333f,
+    94.0515f, 94.14954f, 94.24746f, 94.34526f, 94.44294f, 94.54048f, 94.63792f, 94.73522f,
+    94.83241f, 94.92948f, 95.02642f, 95.123245f, 95.21994f, 95.31653f, 95.412994f, 95.50934f,
+    95.60557f, 95.701675f, 95.79766f, 95.89353f, 95.989296f, 96.08493f, 96.18046f, 96.275856f,
+    96.371155f, 96.46634f, 96.5614f, 96.65634f, 96.75118f, 96.845894f, 96.940506f, 97.035f,
+    97.12939f, 97.223656f, 97.31782f, 97.411865f, 97.50579f, 97.599625f, 97.693344f, 97.78695f,
+    97.88044f, 97.97383f, 98.06711f, 98.16028f, 98.253334f, 98.34629f, 98.43914f, 98.531876f,
+    98.62451f, 98.71703f, 98.80945f, 98.901764f, 98.993965f, 99.086075f, 99.17808f, 99.26996f,
+    99.361755f, 99.45344f, 99.54502f, 99.6365f, 99.727875f, 99.819145f, 99.91032f, 100.00139f,
+    100.092354f, 100.18321f, 100.27398f, 100.36465f, 100.4552f, 100.54567f, 100.636024f,
+    100.726295f, 100.81646f, 100.90652f, 100.99648f, 101.08636f, 101.176125f, 101.2658f, 101.35537f,
+    101.444855f, 101.53423f, 101.62351f, 101.71269f, 101.80178f, 101.89078f, 101.97968f, 102.06849f,
+    102.15719f, 102.245804f, 102.33433f, 102.42275f, 102.51108f, 102.59932f, 102.68747f, 102.77552f,
+    102.86348f, 102.95134f, 103.039116f, 103.1268f, 103.21439f, 103.30189f, 103.3893f, 103.476616f,
+    103.563835f, 103.65098f, 103.73802f, 103.824974f, 103.911835f, 103.99861f, 104.0853f, 104.1719f,
+    104.25841f, 104.34483f, 104.43117f, 104.5174f, 104.60356f, 104.68964f, 104.77562f, 104.8615f,
+    104.94732f, 105.033035f, 105.11867f, 105.204216f, 105.28968f, 105.37505f, 105.46036f,
+    105.545555f, 105.63068f, 105.71571f, 105.80067f, 105.88554f, 105.970314f, 106.05502f,
+    106.13964f, 106.224174f, 106.308624f, 106.39299f, 106.47728f, 106.561485f, 106.6456f,
+    106.72964f, 106.81359f, 106.89747f, 106.98126f, 107.06497f, 107.148605f, 107.232155f,
+    107.31563f, 107.39902f, 107.48233f, 107.56555f, 107.64871f, 107.73178f, 107.814766f, 107.89768f,
+    107.980515f, 108.06328f, 108.14594f, 108.22855f, 108.311066f, 108.39351f, 108.475876f,
+    108.55816f, 108.64037f, 108.7225f, 108.80456f, 108.88653f, 108.96844f, 109.05026f, 109.13201f,
+    109.21369f, 109.29529f, 109.376816f, 109.45826f, 109.53964f, 109.62093f, 109.70215f, 109.78331f,
+    109.86438f, 109.94537f, 110.026306f, 110.107155f, 110.18794f, 110.26864f, 110.34927f,
+    110.429825f, 110.510315f, 110.59073f, 110.67107f, 110.751335f, 110.831535f, 110.91165f,
+    110.99171f, 111.071686f, 111.15159f, 111.23143f, 111.311195f, 111.39089f, 111.47051f,
+    111.55007f, 111.629555f, 111.70897f, 111.78831f, 111.86758f, 111.94678f, 112.02592f, 112.10498f,
+    112.183975f, 112.2629f, 112.34175f, 112.42054f, 112.49925f, 112.57791f, 112.656494f, 112.73501f,
+    112.81345f, 112.89183f, 112.97013f, 113.04838f, 113.12655f, 113.204666f, 113.28271f, 113.36069f,
+    113.43859f, 113.51642f, 113.59421f, 113.671906f, 113.74956f, 113.82713f, 113.90463f, 113.98207f,
+    114.059456f, 114.13677f, 114.21401f, 114.29119f, 114.36832f, 114.44537f, 114.52236f, 114.59928f,
+    114.67615f, 114.752945f, 114.82967f, 114.906334f, 114.98294f, 115.05949f, 115.13595f,
+    115.21237f, 115.28872f, 115.365f, 115.44122f, 115.51739f, 115.59349f, 115.66953f, 115.7455f,
+    115.82142f, 115.89726f, 115.973045f, 116.04877f, 116.12443f, 116.20004f, 116.27558f, 116.35107f,
+    116.42648f, 116.50184f, 116.57713f, 116.652374f, 116.72755f, 116.802666f, 116.877716f,
+    116.952705f, 117.02764f, 117.10251f, 117.17734f, 117.25209f, 117.326775f, 117.40142f, 117.476f,
+    117.55051f, 117.62497f, 117.69937f, 117.773705f, 117.848f, 117.92222f, 117.996376f, 118.07049f,
+    118.14454f, 118.21853f, 118.29246f, 118.366325f, 118.44015f, 118.51391f, 118.58761f, 118.66126f,
+    118.73484f, 118.80838f, 118.88185f, 118.95528f, 119.028625f, 119.10194f, 119.17518f, 119.24836f,
+    119.3215f, 119.39458f, 119.46761f, 119.54058f, 119.61348f, 119.68634f, 119.75913f, 119.83189f,
+    119.90457f, 119.97721f, 120.04978f, 120.1223f, 120.194786f, 120.2672f, 120.33956f, 120.41186f,
+    120.4841f, 120.5563f, 120.62843f, 120.70054f, 120.77257f, 120.84455f, 120.91647f, 120.98835f,
+    121.060165f, 121.13192f, 121.20364f, 121.275314f, 121.34692f, 121.41846f, 121.48995f,
+    121.56142f, 121.63281f, 121.704155f, 121.77545f, 121.84668f, 121.917854f, 121.989006f,
+    122.060074f, 122.13112f, 122.20208f, 122.27302f, 122.34387f, 122.4147f, 122.48549f, 122.556206f,
+    122.62687f, 122.69749f, 122.76805f, 122.83856f, 122.90904f, 122.97945f, 123.04981f, 123.120125f,
+    123.19039f, 123.2606f, 123.33076f, 123.40087f, 123.470924f, 123.54095f, 123.61091f, 123.680824f,
+    123.75068f, 123.82049f, 123.89025f, 123.95996f, 124.02963f, 124.09924f, 124.16882f, 124.238335f,
+    124.30781f, 124.377235f, 124.4466f, 124.515915f, 124.58519f, 124.65441f, 124.723595f,
+    124.792725f, 124.8618f, 124.930824f, 124.999825f, 125.06877f, 125.13765f, 125.20649f,
+    125.27528f, 125.344025f, 125.41273f, 125.481384f, 125.54997f, 125.61854f, 125.68704f,
+    125.755516f, 125.82393f, 125.89229f, 125.960625f, 126.0289f, 126.09713f, 126.16531f, 126.23344f,
+    126.30153f, 126.369576f, 126.43758f, 126.50553f, 126.57344f, 126.64129f, 126.709114f,
+    126.77687f, 126.8446f, 126.91228f, 126.97991f, 127.04749f, 127.11502f, 127.18253f, 127.24998f,
+    127.31738f, 127.38474f, 127.452065f, 127.51933f, 127.58656f, 127.65374f, 127.72087f,
+    127.787964f, 127.85501f, 127.92202f, 127.988976f, 128.05588f, 128.12277f, 128.18959f,
+    128.25638f, 128.3231f, 128.3898f, 128.45645f, 128.52307f, 128.58963f, 128.65616f, 128.72263f,
+    128.78906f, 128.85547f, 128.9218f, 128.98811f, 129.05438f, 129.12059f, 129.18675f, 129.2529f,
+    129.319f, 129.38504f, 129.45105f, 129.51701f, 129.58293f, 129.6488f, 129.71465f, 129.78043f,
+    129.84619f, 129.91188f, 129.97757f, 130.04318f, 130.10878f, 130.17432f, 130.23982f, 130.30528f,
+    130.37068f, 130.43605f, 130.5014f, 130.5667f, 130.63194f, 130.69716f, 130.76233f, 130.82747f,
+    130.89255f, 130.95758f, 131.0226f, 131.08757f, 131.15248f, 131.21738f, 131.28223f, 131.34702f,
+    131.41179f, 131.4765f, 131.54118f, 131.60582f, 131.67043f, 131.735f, 131.79951f, 131.86398f,
+    131.92844f, 131.99283f, 132.0572f, 132.1215f, 132.1858f, 132.25003f, 132.31424f, 132.3784f,
+    132.44254f, 132.5066f, 132.57066f, 132.63466f, 132.69864f, 132.76257f, 132.82646f, 132.89032f,
+    132.95412f, 133.0179f, 133.08163f, 133.14532f, 133.20898f, 133.27261f, 133.3362f, 133.39972f,
+    133.46323f, 133.5267f, 133.59013f, 133.65352f, 133.71686f, 133.78018f, 133.84348f, 133.90668f,
+    133.9699f, 134.03307f, 134.09618f, 134.15927f, 134.2223f, 134.28532f, 134.3483f, 134.41124f,
+    134.47415f, 134.53699f, 134.59982f, 134.66261f, 134.72536f, 134.78807f, 134.85075f, 134.91339f,
+    134.976f, 135.03857f, 135.10109f, 135.16357f, 135.22604f, 135.28845f, 135.35085f, 135.4132f,
+    135.4755f, 135.53777f, 135.6f, 135.66222f, 135.72437f, 135.7865f, 135.84859f, 135.91064f,
+    135.97267f, 136.03467f, 136.09662f, 136.15852f, 136.2204f, 136.28224f, 136.34404f, 136.4058f,
+    136.46754f, 136.52925f, 136.59093f, 136.65256f, 136.71414f, 136.7757f, 136.83722f, 136.89871f,
+    136.96017f, 137.02158f, 137.08298f, 137.1443f, 137.20564f, 137.26692f, 137.32816f, 137.38936f,
+    137.45055f, 137.51167f, 137.57278f, 137.63387f, 137.6949f, 137.75589f, 137.81688f, 137.8778f,
+    137.9387f, 137.99957f, 138.0604f, 138.1212f, 138.18196f, 138.24269f, 138.30338f, 138.36404f,
+    138.42467f, 138.48528f, 138.54582f, 138.60637f, 138.66685f, 138.72733f, 138.78773f, 138.84811f,
+    138.9085f, 138.96881f, 139.02911f, 139.08937f, 139.1496f, 139.20981f, 139.26994f, 139.33008f,
+    139.39018f, 139.45024f, 139.51025f, 139.57027f, 139.63022f, 139.69014f, 139.75006f, 139.8099f,
+    139.86974f, 139.92957f, 139.98932f, 140.04904f, 140.10876f, 140.16843f, 140.22806f, 140.28767f,
+    140.34723f, 140.40677f, 140.46631f, 140.52577f, 140.5852f, 140.64462f, 140.70401f, 140.76334f,
+    140.82268f, 140.88196f, 140.94122f, 141.00043f, 141.05963f, 141.11879f, 141.1779f, 141.23701f,
+    141.29607f, 141.3551f, 141.41411f, 141.47308f, 141.53201f, 141.59093f, 141.6498f, 141.70863f,
+    141.76744f, 141.82623f, 141.885f, 141.94371f, 142.0024f, 142.06107f, 142.1197f, 142.1783f,
+    142.23686f, 142.2954f, 142.35388f, 142.41237f, 142.47081f, 142.52922f, 142.58762f, 142.64597f,
+    142.70428f, 142.76257f, 142.82083f, 142.87907f, 142.93727f, 142.99544f, 143.05359f, 143.1117f,
+    143.16977f, 143.22783f, 143.28586f, 143.34383f, 143.4018f, 143.45972f, 143.51762f, 143.5755f,
+    143.63333f, 143.69116f, 143.74893f, 143.80669f, 143.86441f, 143.92209f, 143.97978f, 144.0374f,
+    144.095f, 144.15257f, 144.21013f, 144.26765f, 144.32513f, 144.38258f, 144.44f, 144.49742f,
+    144.5548f, 144.61214f, 144.66943f, 144.72675f, 144.78398f, 144.8412f, 144.89842f, 144.95558f,
+    145.01273f, 145.06982f, 145.1269f, 145.18396f, 145.24098f, 145.29799f, 145.35497f, 145.41191f,
+    145.46881f, 145.52568f, 145.58255f, 145.63937f, 145.69618f, 145.75294f, 145.80968f, 145.8664f,
+    145.92307f, 145.97974f, 146.03636f, 146.09297f, 146.14954f, 146.20607f, 146.2626f, 146.31908f,
+    146.37555f, 146.43198f, 146.48839f, 146.54477f, 146.60112f, 146.65742f, 146.71373f, 146.77f,
+    146.82623f, 146.88246f, 146.93863f, 146.9948f, 147.05092f, 147.10703f, 147.1631f, 147.21915f,
+    147.27518f, 147.33116f, 147.38713f, 147.44308f, 147.49898f, 147.55487f, 147.61072f, 147.66655f,
+    147.72237f, 147.77814f, 147.83388f, 147.8896f, 147.9453f, 148.00096f, 148.05661f, 148.11224f,
+    148.16783f, 148.22339f, 148.27893f, 148.33443f, 148.38991f, 148.44536f, 148.50081f, 148.5562f,
+    148.61159f, 148.66692f, 148.72226f, 148.77756f, 148.83281f, 148.88806f, 148.94328f, 148.99849f,
+    149.05365f, 149.10878f, 149.1639f, 149.219f, 149.27406f, 149.3291f, 149.3841f, 149.43909f,
+    149.49403f, 149.54898f, 149.60388f, 149.65875f, 149.71362f, 149.76846f, 149.82326f, 149.87805f,
+    149.93279f, 149.98752f, 150.04224f, 150.0969f, 150.15155f, 150.20616f, 150.26076f, 150.31534f,
+    150.36989f, 150.42442f, 150.4789f, 150.53339f, 150.58783f, 150.64226f, 150.69664f, 150.75102f,
+    150.80537f, 150.8597f, 150.914f, 150.96828f, 151.02252f, 151.07675f, 151.13094f, 151.18512f,
+    151.23926f, 151.29338f, 151.34749f, 151.40155f, 151.45558f, 151.50963f, 151.56363f, 151.6176f,
+    151.67155f, 151.72548f, 151.77937f, 151.83325f, 151.8871f, 151.94093f, 151.99474f, 152.04851f,
+    152.10226f, 152.15599f, 152.2097f, 152.26338f, 152.31703f, 152.37067f, 152.42427f, 152.47787f,
+    152.53143f, 152.58496f, 152.63847f, 152.69197f, 152.74544f, 152.79887f, 152.85228f, 152.90567f,
+    152.95905f, 153.01237f, 153.06572f, 153.119f, 153.17229f, 153.22551f, 153.27876f, 153.33195f,
+    153.38513f, 153.4383f, 153.49141f, 153.54451f, 153.59763f, 153.65068f, 153.7037f, 153.75671f,
+    153.80971f, 153.86269f, 153.91562f, 153.96854f, 154.02144f, 154.07431f, 154.12717f, 154.17998f,
+    154.23279f, 154.28557f, 154.33832f, 154.39105f, 154.44377f, 154.49644f, 154.54912f, 154.60178f,
+    154.65437f, 154.70699f, 154.75955f, 154.8121f, 154.86462f, 154.91713f, 154.9696f, 155.02206f,
+    155.0745f, 155.12692f, 155.1793f, 155.23167f, 155.28401f, 155.33633f, 155.38866f, 155.44092f,
+    155.49318f, 155.5454f, 155.59761f, 155.64978f, 155.70197f, 155.7541f, 155.80623f, 155.85834f,
+    155.91039f, 155.96245f, 156.01448f, 156.06648f, 156.11847f, 156.17044f, 156.22237f, 156.27429f,
+    156.32619f, 156.37805f, 156.42992f, 156.48175f, 156.53355f, 156.58534f, 156.63712f, 156.68884f,
+    156.74057f, 156.79227f, 156.84393f, 156.89561f, 156.94725f, 156.99886f, 157.05043f, 157.10199f,
+    157.15355f, 157.20508f, 157.25658f, 157.30804f, 157.35953f, 157.41095f, 157.46239f, 157.51376f,
+    157.56514f, 157.61649f, 157.66782f, 157.71913f, 157.7704f, 157.82167f, 157.87292f, 157.92415f,
+    157.97536f, 158.02654f, 158.07768f, 158.12881f, 158.17995f, 158.23103f, 158.2821f, 158.33316f,
+    158.38419f, 158.43521f, 158.48618f, 158.53716f, 158.5881f, 158.63902f, 158.68994f, 158.74083f,
+    158.79169f, 158.84251f, 158.89336f, 158.94415f, 158.99493f, 159.04568f, 159.09642f, 159.14714f,
+    159.19785f, 159.24852f, 159.29916f, 159.34978f, 159.4004f, 159.45099f, 159.50157f, 159.55211f,
+    159.60265f, 159.65317f, 159.70366f, 159.75412f, 159.80458f, 159.855f, 159.90541f, 159.9558f,
+    160.00616f, 160.0565f, 160.10683f, 160.15714f, 160.20743f, 160.25768f, 160.30794f, 160.35815f,
+    160.40836f, 160.45854f, 160.50871f, 160.55885f, 160.60896f, 160.65907f, 160.70915f, 160.75922f,
+    160.80925f, 160.8593f, 160.90929f, 160.95927f, 161.00923f, 161.05917f, 161.1091f, 161.15901f,
+    161.2089f, 161.25874f, 161.3086f, 161.35841f, 161.40822f, 161.45801f, 161.50777f, 161.55751f,
+    161.60722f, 161.65695f, 161.70662f, 161.7563f, 161.80594f, 161.85556f, 161.90517f, 161.95476f,
+    162.00432f, 162.05388f, 162.10341f, 162.15291f, 162.2024f, 162.25188f, 162.30132f, 162.35074f,
+    162.40018f, 162.44955f, 162.49893f, 162.54828f, 162.59761f, 162.64693f, 162.69621f, 162.7455f,
+    162.79475f, 162.844f, 162.89322f, 162.94241f, 162.99161f, 163.04076f, 163.0899f, 163.13904f,
+    163.18814f, 163.23721f, 163.28629f, 163.33534f, 163.38437f, 163.43338f, 163.48236f, 163.53134f,
+    163.58029f, 163.62923f, 163.67813f, 163.72704f, 163.77591f, 163.82475f, 163.87361f, 163.92242f,
+    163.97124f, 164.02f, 164.06877f, 164.11751f, 164.16626f, 164.21497f, 164.26366f, 164.31233f,
+    164.36098f, 164.4096f, 164.45824f, 164.50682f, 164.5554f, 164.60396f, 164.6525f, 164.70102f,
+    164.74953f, 164.79802f, 164.8465f, 164.89493f, 164.94336f, 164.99178f, 165.04018f, 165.08856f,
+    165.1369f, 165.18526f, 165.23355f, 165.28188f, 165.33017f, 165.37842f, 165.42668f, 165.4749f,
+    165.52313f, 165.57132f, 165.61948f, 165.66765f, 165.71577f, 165.7639f, 165.81201f, 165.86009f,
+    165.90816f, 165.95622f, 166.00424f, 166.05228f, 166.10027f, 166.14824f, 166.1962f, 166.24416f,
+    166.29205f, 166.33997f, 166.38788f, 166.43573f, 166.48358f, 166.53143f, 166.57924f, 166.62704f,
+    166.67482f, 166.7226f, 166.77032f, 166.81805f, 166.86578f, 166.91347f, 166.96115f, 167.0088f,
+    167.05646f, 167.10408f, 167.15169f, 167.19928f, 167.24684f, 167.2944f, 167.34192f, 167.38945f,
+    167.43695f, 167.48444f, 167.53192f, 167.57935f, 167.62679f, 167.67421f, 167.7216f, 167.76898f,
+    167.81635f, 167.8637f, 167.91101f, 167.95833f, 168.00562f, 168.05292f, 168.10017f, 168.1474f,
+    168.19463f, 168.24184f, 168.28903f, 168.3362f, 168.38336f, 168.43051f, 168.47762f, 168.52472f,
+    168.57182f, 168.61888f, 168.66594f, 168.71298f, 168.76001f, 168.807f, 168.85399f, 168.90096f,
+    168.94794f, 168.99487f, 169.04178f, 169.08868f, 169.13556f, 169.18243f, 169.2293f, 169.27611f,
+    169.32294f, 169.36974f, 169.41653f, 169.46329f, 169.51006f, 169.55678f, 169.6035f, 169.65019f,
+    169.69688f, 169.74356f, 169.79022f, 169.83685f, 169.88345f, 169.93007f, 169.97665f, 170.02322f,
+    170.06976f, 170.1163f, 170.16284f, 170.20935f, 170.25584f, 170.3023f, 170.34875f, 170.3952f,
+    170.44162f, 170.48802f, 170.53441f, 170.58078f, 170.62714f, 170.67348f, 170.7198f, 170.76611f,
+    170.81241f, 170.85867f, 170.90494f, 170.95119f, 170.9974f, 171.04362f, 171.08981f, 171.13599f,
+    171.18216f, 171.2283f, 171.27443f, 171.32056f, 171.36664f, 171.41272f, 171.45879f, 171.50485f,
+    171.55089f, 171.59688f, 171.64288f, 171.68887f, 171.73485f, 171.7808f, 171.82674f, 171.87265f,
+    171.91856f, 171.96445f, 172.01033f, 172.0562f, 172.10204f, 172.14786f, 172.19368f, 172.23947f,
+    172.28525f, 172.33101f, 172.37675f, 172.4225f, 172.46822f, 172.51392f, 172.5596f, 172.60527f,
+    172.65092f, 172.69655f, 172.74219f, 172.7878f, 172.83339f, 172.87895f, 172.92451f, 172.97006f,
+    173.01558f, 173.06113f, 173.10661f, 173.15208f, 173.19757f, 173.24303f, 173.28844f, 173.33388f,
+    173.37927f, 173.42467f, 173.47005f, 173.51541f, 173.56073f, 173.60608f, 173.65138f, 173.69669f,
+    173.74197f, 173.78723f, 173.83247f, 173.87773f, 173.92296f, 173.96817f, 174.01335f, 174.05853f,
+    174.1037f, 174.14882f, 174.19395f, 174.23907f, 174.28418f, 174.32927f, 174.37433f, 174.41939f,
+    174.46443f, 174.50945f, 174.55447f, 174.59946f, 174.64444f, 174.6894f, 174.73438f, 174.7793f,
+    174.8242f, 174.86913f, 174.914f, 174.9589f, 175.00374f, 175.0486f, 175.09341f, 175.13824f,
+    175.18304f, 175.22783f, 175.2726f, 175.31735f, 175.36209f, 175.40681f, 175.45154f, 175.49623f,
+    175.54091f, 175.58557f, 175.63023f, 175.67488f, 175.7195f, 175.76411f, 175.8087f, 175.85329f,
+    175.89786f, 175.94238f, 175.98694f, 176.03145f, 176.07596f, 176.12044f, 176.16493f, 176.20938f,
+    176.25385f, 176.29828f, 176.34268f, 176.3871f, 176.43149f, 176.47586f, 176.52023f, 176.56456f,
+    176.6089f, 176.65321f, 176.69753f, 176.74182f, 176.78609f, 176.83035f, 176.8746f, 176.91882f,
+    176.96304f, 177.00725f, 177.05144f, 177.09561f, 177.13976f, 177.18391f, 177.22806f, 177.27216f,
+    177.31627f, 177.36037f, 177.40442f, 177.44849f, 177.49254f, 177.53656f, 177.58058f, 177.62459f,
+    177.66858f, 177.71255f, 177.75653f, 177.80046f, 177.84439f, 177.88832f, 177.93222f, 177.9761f,
+    178.01999f, 178.06386f, 178.10771f, 178.15154f, 178.19536f, 178.23917f, 178.28296f, 178.32674f,
+    178.37051f, 178.41426f, 178.45801f, 178.50171f, 178.54543f, 178.58911f, 178.6328f, 178.67647f,
+    178.72012f, 178.76375f, 178.80739f, 178.85101f, 178.89459f, 178.93819f, 178.98175f, 179.02533f,
+    179.06886f, 179.11238f, 179.15591f, 179.1994f, 179.2429f, 179.28638f, 179.32983f, 179.37328f,
+    179.4167f, 179.46013f, 179.50354f, 179.54694f, 179.59033f, 179.63367f, 179.67703f, 179.72037f,
+    179.76369f, 179.807f, 179.8503f, 179.8936f, 179.93686f, 179.98012f, 180.02336f, 180.06659f,
+    180.1098f, 180.15302f, 180.19621f, 180.23938f, 180.28255f, 180.3257f, 180.36884f, 180.41194f,
+    180.45506f, 180.49814f, 180.54123f, 180.5843f, 180.62737f, 180.6704f, 180.71344f, 180.75645f,
+    180.79945f, 180.84244f, 180.88542f, 180.92839f, 180.97133f, 181.01428f, 181.0572f, 181.10011f,
+    181.143f, 181.18588f, 181.22876f, 181.2716f, 181.31444f, 181.35727f, 181.4001f, 181.4429f,
+    181.4857f, 181.52847f, 181.57124f, 181.614f, 181.65674f, 181.69948f, 181.74217f, 181.78488f,
+    181.82756f, 181.87025f, 181.9129f, 181.95555f, 181.99818f, 182.04082f, 182.08342f, 182.126f,
+    182.1686f, 182.21117f, 182.25372f, 182.29626f, 182.33879f, 182.38132f, 182.42381f, 182.46631f,
+    182.5088f, 182.55125f, 182.59372f, 182.63617f, 182.67859f, 182.72101f, 182.7634f, 182.8058f,
+    182.84818f, 182.89053f, 182.93289f, 182.97523f, 183.01756f, 183.05988f, 183.10217f, 183.14445f,
+    183.18672f, 183.22899f, 183.27126f, 183.31349f, 183.35571f, 183.39793f, 183.44011f, 183.4823f,
+    183.52448f, 183.56665f, 183.6088f, 183.65092f, 183.69305f, 183.73515f, 183.77728f, 183.81935f,
+    183.86142f, 183.90349f, 183.94554f, 183.98756f, 184.0296f, 184.07161f, 184.1136f, 184.15558f,
+    184.19757f, 184.23953f, 184.28148f, 184.32341f, 184.36534f, 184.40724f, 184.44914f, 184.49104f,
+    184.5329f, 184.57478f, 184.61664f, 184.65846f, 184.70029f, 184.74211f, 184.7839f, 184.8257f,
+    184.86746f, 184.90924f, 184.95097f, 184.99272f, 185.03444f, 185.07617f, 185.11787f, 185.15956f,
+    185.20125f, 185.2429f, 185.28456f, 185.32619f, 185.36783f, 185.40944f, 185.45105f, 185.49265f,
+    185.53423f, 185.57579f, 185.61736f, 185.6589f, 185.70042f, 185.74194f, 185.78346f, 185.82495f,
+    185.86644f, 185.90791f, 185.94937f, 185.99081f, 186.03224f, 186.07367f, 186.11508f, 186.15648f,
+    186.19786f, 186.23926f, 186.28061f, 186.32198f, 186.36331f, 186.40462f, 186.44595f, 186.48726f,
+    186.52853f, 186.56982f, 186.6111f, 186.65236f, 186.6936f, 186.73483f, 186.77605f, 186.81726f,
+    186.85846f, 186.89964f, 186.94083f, 186.982f, 187.02313f, 187.06427f, 187.1054f, 187.14651f,
+    187.18762f, 187.2287f, 187.26979f, 187.31085f, 187.35193f, 187.39294f, 187.43399f, 187.475f,
+    187.51602f, 187.55702f, 187.59802f, 187.63898f, 187.67995f, 187.72089f, 187.76183f, 187.80276f,
+    187.84366f, 187.88458f, 187.92548f, 187.96635f, 188.00722f, 188.04808f, 188.08891f, 188.12978f,
+    188.1706f, 188.21141f, 188.25218f, 188.29298f, 188.33376f, 188.37453f, 188.4153f, 188.45604f,
+    188.49677f, 188.53748f, 188.5782f, 188.61888f, 188.65958f, 188.70024f, 188.74092f, 188.78156f,
+    188.8222f, 188.86284f, 188.90344f, 188.94408f, 188.98465f, 189.02524f, 189.0658f, 189.10637f,
+    189.14691f, 189.18745f, 189.22798f, 189.2685f, 189.309f, 189.34949f, 189.38997f, 189.43045f,
+    189.4709f, 189.51135f, 189.55177f, 189.59222f, 189.63263f, 189.67302f, 189.71341f, 189.75381f,
+    189.79416f, 189.83453f, 189.87486f, 189.91522f, 189.95554f, 189.99583f, 190.03615f, 190.07645f,
+    190.11671f, 190.157f, 190.19725f, 190.23749f, 190.27773f, 190.31796f, 190.35817f, 190.39838f,
+    190.43857f, 190.47873f, 190.5189f, 190.55907f, 190.59921f, 190.63934f, 190.67947f, 190.71959f,
+    190.75969f, 190.79979f, 190.83986f, 190.87994f, 190.92f, 190.96004f, 191.00008f, 191.0401f,
+    191.08012f, 191.1201f, 191.16013f, 191.2001f, 191.24008f, 191.28003f, 191.31998f, 191.35992f,
+    191.39984f, 191.43976f, 191.47968f, 191.51956f, 191.55943f, 191.59932f, 191.63919f, 191.67903f,
+    191.71887f, 191.75871f, 191.79852f, 191.83833f, 191.87813f, 191.91792f, 191.95769f, 191.99747f,
+    192.03722f, 192.07695f, 192.1167f, 192.15642f, 192.19614f, 192.23584f, 192.27551f, 192.31519f,
+    192.35487f, 192.39455f, 192.43419f, 192.4738f, 192.51343f, 192.55305f, 192.59267f, 192.63226f,
+    192.67186f, 192.71141f, 192.75098f, 192.79053f, 192.83006f, 192.86961f, 192.90913f, 192.94862f,
+    192.98814f, 193.02762f, 193.0671f, 193.10658f, 193.14603f, 193.18547f, 193.22491f, 193.26433f,
+    193.30374f, 193.34315f, 193.38255f, 193.42195f, 193.46132f, 193.50069f, 193.54002f, 193.57938f,
+    193.61868f, 193.65802f, 193.69733f, 193.73663f, 193.77592f, 193.8152f, 193.85448f, 193.89374f,
+    193.93297f, 193.97221f, 194.01143f, 194.05066f, 194.08986f, 194.12906f, 194.16824f, 194.20743f,
+    194.2466f, 194.28575f, 194.3249f, 194.36403f, 194.40315f, 194.44228f, 194.48137f, 194.52045f,
+    194.55956f, 194.5986f, 194.63766f, 194.67673f, 194.71577f, 194.7548f, 194.79382f, 194.83284f,
+    194.87186f, 194.91083f, 194.94981f, 194.9888f, 195.02774f, 195.0667f, 195.10565f, 195.14458f,
+    195.1835f, 195.2224f, 195.26129f, 195.3002f, 195.33907f, 195.37794f, 195.41681f, 195.45564f,
+    195.49449f, 195.53331f, 195.57214f, 195.61095f, 195.64975f, 195.68854f, 195.72731f, 195.76608f,
+    195.80484f, 195.8436f, 195.88234f, 195.92107f, 195.95978f, 195.99849f, 196.0372f, 196.07588f,
+    196.11456f, 196.15323f, 196.19188f, 196.23053f, 196.26917f, 196.3078f, 196.34642f, 196.38503f,
+    196.42363f, 196.46222f, 196.50081f, 196.53937f, 196.57793f, 196.61649f, 196.65503f, 196.69356f,
+    196.73207f, 196.77058f, 196.80908f, 196.84756f, 196.88606f, 196.92453f, 196.963f, 197.00143f,
+    197.03989f, 197.07832f, 197.11674f, 197.15514f, 197.19354f, 197.23195f, 197.27032f, 197.3087f,
+    197.34708f, 197.38542f, 197.42377f, 197.46208f, 197.50043f, 197.53874f, 197.57704f, 197.61534f,
+    197.65363f, 197.6919f, 197.73018f, 197.76843f, 197.80667f, 197.84491f, 197.88313f, 197.92134f,
+    197.95956f, 197.99776f, 198.03595f, 198.07413f, 198.11229f, 198.15047f, 198.18861f, 198.22676f,
+    198.2649f, 198.303f, 198.34113f, 198.37923f, 198.41733f, 198.4554f, 198.49347f, 198.53154f,
+    198.5696f, 198.60764f, 198.64568f, 198.6837f, 198.72173f, 198.75972f, 198.79771f, 198.83571f,
+    198.8737f, 198.91165f, 198.94962f, 198.98756f, 199.02553f, 199.06345f, 199.10136f, 199.13927f,
+    199.17719f, 199.21507f, 199.25296f, 199.29083f, 199.32869f, 199.36655f, 199.40439f, 199.44225f,
+    199.48007f, 199.51788f, 199.5557f, 199.5935f, 199.63129f, 199.66907f, 199.70683f, 199.7446f,
+    199.78236f, 199.8201f, 199.85783f, 199.89555f, 199.93327f, 199.971f, 200.00868f, 200.04636f,
+    200.08405f, 200.1217f, 200.15938f, 200.19704f, 200.23466f, 200.2723f, 200.30992f, 200.34753f,
+    200.38513f, 200.42274f, 200.46033f, 200.4979f, 200.53548f, 200.57301f, 200.61057f, 200.64812f,
+    200.68565f, 200.72316f, 200.76068f, 200.79819f, 200.83566f, 200.87317f, 200.91063f, 200.9481f,
+    200.98555f, 201.02301f, 201.06046f, 201.09789f, 201.1353f, 201.17271f, 201.21011f, 201.24751f,
+    201.2849f, 201.32227f, 201.35965f, 201.397f, 201.43436f, 201.47168f, 201.509f, 201.54634f,
+    201.58365f, 201.62096f, 201.65825f, 201.69553f, 201.73282f, 201.77007f, 201.80733f, 201.84457f,
+    201.88184f, 201.91905f, 201.95627f, 201.9935f, 202.03069f, 202.06789f, 202.10506f, 202.14226f,
+    202.17941f, 202.21658f, 202.25372f, 202.29086f, 202.328f, 202.36511f, 202.40225f, 202.43935f,
+    202.47644f, 202.51352f, 202.55061f, 202.58768f, 202.62476f, 202.66179f, 202.69884f, 202.73587f,
+    202.7729f, 202.80992f, 202.84694f, 202.88393f, 202.92093f, 202.9579f, 202.99487f, 203.03183f,
+    203.0688f, 203.10574f, 203.14267f, 203.1796f, 203.21654f, 203.25343f, 203.29034f, 203.32722f,
+    203.36412f, 203.40099f, 203.43787f, 203.47472f, 203.51158f, 203.5484f, 203.58524f, 203.62207f,
+    203.65887f, 203.69568f, 203.73248f, 203.76927f, 203.80606f, 203.84283f, 203.87958f, 203.91635f,
+    203.95308f, 203.98982f, 204.02655f, 204.06328f, 204.09999f, 204.13669f, 204.17339f, 204.21005f,
+    204.24673f, 204.2834f, 204.32007f, 204.35672f, 204.39336f, 204.43f, 204.4666f, 204.50323f,
+    204.53984f, 204.57643f, 204.61304f, 204.6496f, 204.68617f, 204.72275f, 204.7593f, 204.79587f,
+    204.83238f, 204.86891f, 204.90544f, 204.94196f, 204.97847f, 205.01495f, 205.05144f, 205.08792f,
+    205.1244f, 205.16086f, 205.19731f, 205.23376f, 205.2702f, 205.30663f, 205.34303f, 205.37946f,
+    205.41585f, 205.45226f, 205.48865f, 205.52501f, 205.56137f, 205.59775f, 205.6341f, 205.67044f,
+    205.70679f, 205.7431f, 205.77942f, 205.81573f, 205.85202f, 205.88834f, 205.92462f, 205.96089f,
+    205.99716f, 206.03342f, 206.06967f, 206.10591f, 206.14215f, 206.17838f, 206.2146f, 206.25081f,
+    206.28699f, 206.32318f, 206.35938f, 206.39557f, 206.43173f, 206.4679f, 206.50404f, 206.54018f,
+    206.57632f, 206.61244f, 206.64856f, 206.68466f, 206.72078f, 206.75688f, 206.79295f, 206.82903f,
+    206.8651f, 206.90117f, 206.9372f, 206.97325f, 207.00931f, 207.04532f, 207.08134f, 207.11734f,
+    207.15337f, 207.18935f, 207.22534f, 207.2613f, 207.29729f, 207.33325f, 207.3692f, 207.40514f,
+    207.44109f, 207.47702f, 207.51292f, 207.54884f, 207.58475f, 207.62067f, 207.65654f, 207.69243f,
+    207.7283f, 207.76416f, 207.80002f, 207.83586f, 207.8717f, 207.90755f, 207.94336f, 207.97917f,
+    208.01497f, 208.05078f, 208.08658f, 208.12236f, 208.15814f, 208.1939f, 208.22964f, 208.26541f,
+    208.30116f, 208.33688f, 208.37262f, 208.40833f, 208.44405f, 208.47975f, 208.51546f, 208.55113f,
+    208.58679f, 208.62248f, 208.65814f, 208.69379f, 208.72946f, 208.76509f, 208.8007f, 208.83633f,
+    208.87196f, 208.90756f, 208.94316f, 208.97876f, 209.01433f, 209.04991f, 209.08548f, 209.12103f,
+    209.15659f, 209.19214f, 209.22768f, 209.2632f, 209.2987f, 209.33421f, 209.36974f, 209.40523f,
+    209.4407f, 209.4762f, 209.51167f, 209.54713f, 209.58258f, 209.61804f, 209.65347f, 209.68892f,
+    209.72433f, 209.75977f, 209.79517f, 209.83058f, 209.86597f, 209.90135f, 209.93672f, 209.97209f,
+    210.00745f, 210.04282f, 210.07816f, 210.1135f, 210.14883f, 210.18414f, 210.21947f, 210.25479f,
+    210.29008f, 210.32538f, 210.36066f, 210.39594f, 210.4312f, 210.46646f, 210.50172f, 210.53696f,
+    210.57219f, 210.60742f, 210.64265f, 210.67787f, 210.71309f, 210.74828f, 210.78346f, 210.81866f,
+    210.85382f, 210.889f, 210.92415f, 210.95932f, 210.99446f, 211.0296f, 211.06473f, 211.09985f,
+    211.13496f, 211.17006f, 211.20515f, 211.24025f, 211.27533f, 211.31041f, 211.34549f, 211.38054f,
+    211.41559f, 211.45064f, 211.48569f, 211.52072f, 211.55574f, 211.59076f, 211.62576f, 211.66075f,
+    211.69576f, 211.73074f, 211.76572f, 211.80069f, 211.83565f, 211.8706f, 211.90555f, 211.94048f,
+    211.97542f, 212.01036f, 212.04527f, 212.08018f, 212.11508f, 212.14998f, 212.18488f, 212.21974f,
+    212.25462f, 212.28949f, 212.32434f, 212.35919f, 212.39403f, 212.42886f, 212.46368f, 212.49849f,
+    212.53331f, 212.56812f, 212.60292f, 212.63771f, 212.67249f, 212.70724f, 212.74202f, 212.7768f,
+    212.81154f, 212.84628f, 212.88101f, 212.91576f, 212.95049f, 212.9852f, 213.0199f, 213.0546f,
+    213.0893f, 213.12398f, 213.15865f, 213.19331f, 213.228f, 213.26263f, 213.29729f, 213.33192f,
+    213.36656f, 213.4012f, 213.43579f, 213.47041f, 213.50502f, 213.5396f, 213.57422f, 213.6088f,
+    213.64336f, 213.67793f, 213.71248f, 213.74704f, 213.78157f, 213.81612f, 213.85066f, 213.8852f,
+    213.9197f, 213.9542f, 213.98871f, 214.0232f, 214.05768f, 214.09216f, 214.12665f, 214.1611f,
+    214.19556f, 214.23f, 214.26445f, 214.29889f, 214.33331f, 214.36774f, 214.40215f, 214.43655f,
+    214.47095f, 214.50534f, 214.53972f, 214.57411f, 214.60849f, 214.64284f, 214.67719f, 214.71153f,
+    214.74588f, 214.78023f, 214.81454f, 214.84886f, 214.88318f, 214.91747f, 214.95178f, 214.98608f,
+    215.02036f, 215.05463f, 215.08888f, 215.12317f, 215.15741f, 215.19167f, 215.22589f, 215.26013f,
+    215.29437f, 215.3286f, 215.3628f, 215.39699f, 215.43118f, 215.4654f, 215.49957f, 215.53374f,
+    215.5679f, 215.60208f, 215.63625f, 215.67038f, 215.70451f, 215.73865f, 215.77278f, 215.8069f,
+    215.84102f, 215.8751f, 215.90921f, 215.94331f, 215.9774f, 216.01147f, 216.04553f, 216.07962f,
+    216.11365f, 216.1477f, 216.18175f, 216.21579f, 216.2498f, 216.28383f, 216.31784f, 216.35185f,
+    216.38585f, 216.41985f, 216.45383f, 216.48781f, 216.52177f, 216.55574f, 216.5897f, 216.62366f,
+    216.6576f, 216.69151f, 216.72546f, 216.75938f, 216.79329f, 216.82721f, 216.86111f, 216.89499f,
+    216.9289f, 216.96278f, 216.99664f, 217.0305f, 217.06438f, 217.09822f, 217.13206f, 217.16591f,
+    217.19975f, 217.23357f, 217.26738f, 217.30121f, 217.33499f, 217.36879f, 217.40259f, 217.43637f,
+    217.47014f, 217.50392f, 217.53769f, 217.57143f, 217.6052f, 217.63893f, 217.67267f, 217.70639f,
+    217.74011f, 217.77383f, 217.80754f, 217.84123f, 217.87492f, 217.90863f, 217.94229f, 217.97597f,
+    218.00963f, 218.0433f, 218.07693f, 218.11061f, 218.14423f, 218.17786f, 218.2115f, 218.2451f,
+    218.27873f, 218.31233f, 218.34593f, 218.37953f, 218.4131f, 218.44667f, 218.48027f, 218.51382f,
+    218.54738f, 218.58093f, 218.61447f, 218.64801f, 218.68153f, 218.71506f, 218.74858f, 218.78209f,
+    218.81561f, 218.8491f, 218.88258f, 218.91606f, 218.94954f, 218.98302f, 219.01648f, 219.04994f,
+    219.08339f, 219.11682f, 219.15027f, 219.18369f, 219.21712f, 219.25053f, 219.28394f, 219.31735f,
+    219.35074f, 219.38412f, 219.41751f, 219.45088f, 219.48425f, 219.51762f, 219.55098f, 219.58434f,
+    219.61766f, 219.651f, 219.68434f, 219.71767f, 219.75098f, 219.78429f, 219.8176f, 219.85088f,
+    219.88417f, 219.91745f, 219.95073f, 219.984f, 220.01727f, 220.05052f, 220.08379f, 220.11702f,
+    220.15027f, 220.18349f, 220.2167f, 220.24992f, 220.28311f, 220.31633f, 220.34952f, 220.38272f,
+    220.41591f, 220.4491f, 220.48224f, 220.51543f, 220.54857f, 220.58174f, 220.61487f, 220.64801f,
+    220.68115f, 220.71426f, 220.74739f, 220.7805f, 220.8136f, 220.8467f, 220.87979f, 220.91287f,
+    220.94595f, 220.97903f, 221.0121f, 221.04517f, 221.07822f, 221.11127f, 221.14429f, 221.17732f,
+    221.21036f, 221.24338f, 221.27638f, 221.30942f, 221.3424f, 221.3754f, 221.40837f, 221.44136f,
+    221.47433f, 221.50731f, 221.54025f, 221.57323f, 221.60616f, 221.63911f, 221.67204f, 221.70499f,
+    221.7379f, 221.77083f, 221.80374f, 221.83664f, 221.86955f, 221.90244f, 221.93532f, 221.96819f,
+    222.00107f, 222.03394f, 222.06679f, 222.09966f, 222.13249f, 222.16533f, 222.19817f, 222.231f,
+    222.26381f, 222.29663f, 222.32942f, 222.36224f, 222.39503f, 222.42783f, 222.4606f, 222.49338f,
+    222.52615f, 222.5589f, 222.59167f, 222.62444f, 222.65717f, 222.68991f, 222.72264f, 222.75537f,
+    222.78809f, 222.8208f, 222.85352f, 222.8862f, 222.9189f, 222.95158f, 222.98427f, 223.01694f,
+    223.0496f, 223.08228f, 223.11493f, 223.14757f, 223.18022f, 223.21284f, 223.24548f, 223.27812f,
+    223.31073f, 223.34335f, 223.37596f, 223.40855f, 223.44115f, 223.47372f, 223.50632f, 223.53891f,
+    223.57146f, 223.60402f, 223.6366f, 223.66911f, 223.70168f, 223.7342f, 223.76674f, 223.79927f,
+    223.83177f, 223.8643f, 223.8968f, 223.9293f, 223.96179f, 223.9943f, 224.02676f, 224.05923f,
+    224.09172f, 224.12416f, 224.15662f, 224.18909f, 224.22151f, 224.25395f, 224.28639f, 224.31882f,
+    224.35124f, 224.38365f, 224.41605f, 224.44846f, 224.48085f, 224.51324f, 224.54562f, 224.578f,
+    224.61037f, 224.64273f, 224.6751f, 224.70744f, 224.73979f, 224.77214f, 224.80444f, 224.83678f,
+    224.86911f, 224.90141f, 224.93373f, 224.96603f, 224.99834f, 225.03061f, 225.06291f, 225.0952f,
+    225.12744f, 225.15971f, 225.19199f, 225.22423f, 225.25648f, 225.28871f, 225.32097f, 225.3532f,
+    225.3854f, 225.41763f, 225.44984f, 225.48206f, 225.51425f, 225.54643f, 225.57863f, 225.61081f,
+    225.64299f, 225.67516f, 225.7073f, 225.73946f, 225.77162f, 225.80377f, 225.83589f, 225.86803f,
+    225.90018f, 225.9323f, 225.9644f, 225.9965f, 226.02861f, 226.06071f, 226.09279f, 226.12488f,
+    226.15695f, 226.18903f, 226.22108f, 226.25316f, 226.28522f, 226.31726f, 226.3493f, 226.38133f,
+    226.41338f, 226.4454f, 226.47742f, 226.50941f, 226.54143f, 226.57344f, 226.60544f, 226.6374f,
+    226.6694f, 226.70139f, 226.73335f, 226.7653f, 226.79727f, 226.82922f, 226.86118f, 226.89311f,
+    226.92505f, 226.95699f, 226.9889f, 227.02084f, 227.05275f, 227.08463f, 227.11655f, 227.14844f,
+    227.18033f, 227.21222f, 227.24408f, 227.27596f, 227.30782f, 227.33968f, 227.37154f, 227.40338f,
+    227.43521f, 227.46706f, 227.49889f, 227.5307f, 227.56255f, 227.59433f, 227.62614f, 227.65794f,
+    227.68974f, 227.72153f, 227.75331f, 227.78508f, 227.81685f, 227.84862f, 227.88039f, 227.91214f,
+    227.9439f, 227.9756f, 228.00735f, 228.03908f, 228.07082f, 228.10254f, 228.13423f, 228.16594f,
+    228.19765f, 228.22934f, 228.26103f, 228.29271f, 228.3244f, 228.35606f, 228.38773f, 228.41939f,
+    228.45103f, 228.4827f, 228.51433f, 228.54597f, 228.5776f, 228.60924f, 228.64084f, 228.67247f,
+    228.70407f, 228.73567f, 228.76727f, 228.79886f, 228.83044f, 228.86203f, 228.8936f, 228.92516f,
+    228.95674f, 228.98828f, 229.01984f, 229.05138f, 229.08292f, 229.11447f, 229.146f, 229.1775f,
+    229.20901f, 229.24052f, 229.27203f, 229.30353f, 229.33502f, 229.36652f, 229.398f, 229.42947f,
+    229.46095f, 229.49242f, 229.52386f, 229.55533f, 229.58678f, 229.61821f, 229.64964f, 229.68108f,
+    229.71251f, 229.74394f, 229.77534f, 229.80675f, 229.83817f, 229.86957f, 229.90094f, 229.93233f,
+    229.9637f, 229.99507f, 230.02644f, 230.0578f, 230.08917f, 230.12051f, 230.15187f, 230.1832f,
+    230.21455f, 230.24586f, 230.2772f, 230.30852f, 230.33984f, 230.37114f, 230.40244f, 230.43375f,
+    230.46503f, 230.4963f, 230.5276f, 230.55885f, 230.59012f, 230.62137f, 230.65265f, 230.6839f,
+    230.71513f, 230.74637f, 230.7776f, 230.80884f, 230.84006f, 230.87128f, 230.90248f, 230.93369f,
+    230.9649f, 230.99608f, 231.02727f, 231.05846f, 231.08965f, 231.12082f, 231.15198f, 231.18315f,
+    231.21431f, 231.24545f, 231.27661f, 231.30772f, 231.33887f, 231.37f, 231.40112f, 231.43224f,
+    231.46335f, 231.49446f, 231.52556f, 231.55666f, 231.58775f, 231.61882f, 231.6499f, 231.68098f,
+    231.71205f, 231.74312f, 231.77415f, 231.80522f, 231.83626f, 231.86731f, 231.89833f, 231.92937f,
+    231.96039f, 231.9914f, 232.02243f, 232.05342f, 232.08444f, 232.11543f, 232.14641f, 232.1774f,
+    232.2084f, 232.23936f, 232.27034f, 232.3013f, 232.33224f, 232.36322f, 232.39417f, 232.4251f,
+    232.45604f, 232.48697f, 232.51788f, 232.54881f, 232.57971f, 232.61063f, 232.64153f, 232.67242f,
+    232.70332f, 232.7342f, 232.76509f, 232.79599f, 232.82686f, 232.85773f, 232.88858f, 232.91945f,
+    232.95027f, 232.98112f, 233.01196f, 233.0428f, 233.07362f, 233.10445f, 233.13527f, 233.16606f,
+    233.19688f, 233.22769f, 233.25848f, 233.28928f, 233.32007f, 233.35085f, 233.38162f, 233.41238f,
+    233.44315f, 233.47389f, 233.50465f, 233.5354f, 233.56616f, 233.5969f, 233.62762f, 233.65836f,
+    233.68906f, 233.71979f, 233.75049f, 233.78119f, 233.8119f, 233.8426f, 233.87329f, 233.90396f,
+    233.93465f, 233.96532f, 233.99599f, 234.02664f, 234.0573f, 234.08794f, 234.11862f, 234.14926f,
+    234.17989f, 234.21051f, 234.24113f, 234.27176f, 234.30237f, 234.333f, 234.3636f, 234.3942f,
+    234.42479f, 234.45537f, 234.48596f, 234.51654f, 234.54709f, 234.57767f, 234.60823f, 234.6388f,
+    234.66934f, 234.69987f, 234.73042f, 234.76097f, 234.7915f, 234.82202f, 234.85254f, 234.88306f,
+    234.91356f, 234.94406f, 234.97458f, 235.00507f, 235.03555f, 235.06602f, 235.09651f, 235.12698f,
+    235.15747f, 235.18791f, 235.21838f, 235.24883f, 235.27928f, 235.30971f, 235.34015f, 235.37059f,
+    235.40102f, 235.43144f, 235.46185f, 235.49226f, 235.52266f, 235.55307f, 235.58347f, 235.61385f,
+    235.64424f, 235.67462f, 235.705f, 235.73537f, 235.76572f, 235.79607f, 235.82643f, 235.8568f,
+    235.88713f, 235.91747f, 235.9478f, 235.97813f, 236.00845f, 236.03877f, 236.06908f, 236.09941f,
+    236.1297f, 236.16f, 236.19028f, 236.22057f, 236.25085f, 236.28113f, 236.3114f, 236.34167f,
+    236.37192f, 236.40219f, 236.43243f, 236.46268f, 236.4929f, 236.52316f, 236.55339f, 236.58362f,
+    236.61383f, 236.64406f, 236.67426f, 236.70447f, 236.73466f, 236.76486f, 236.79506f, 236.82523f,
+    236.85541f, 236.88557f, 236.91577f, 236.94592f, 236.97609f, 237.00623f, 237.03638f, 237.06653f,
+    237.09666f, 237.1268f, 237.15694f, 237.18704f, 237.21718f, 237.2473f, 237.27739f, 237.3075f,
+    237.3376f, 237.3677f, 237.39778f, 237.42786f, 237.45793f, 237.48802f, 237.51808f, 237.54814f,
+    237.5782f, 237.60826f, 237.6383f, 237.66835f, 237.6984f, 237.72842f, 237.75844f, 237.78847f,
+    237.8185f, 237.84851f, 237.87851f, 237.90852f, 237.93852f, 237.9685f, 237.99847f, 238.02847f,
+    238.05846f, 238.08842f, 238.11841f, 238.14838f, 238.17831f, 238.20828f, 238.23822f, 238.26816f,
+    238.2981f, 238.32805f, 238.35796f, 238.38788f, 238.41782f, 238.44771f, 238.47763f, 238.50752f,
+    238.53743f, 238.56732f, 238.59721f, 238.6271f, 238.65697f, 238.68686f, 238.71672f, 238.74657f,
+    238.77644f, 238.80629f, 238.83615f, 238.866f, 238.89583f, 238.92566f, 238.9555f, 238.98532f,
+    239.01514f, 239.04497f, 239.07477f, 239.10455f, 239.13438f, 239.16417f, 239.19395f, 239.22374f,
+    239.25351f, 239.28328f, 239.31306f, 239.34283f, 239.37259f, 239.40236f, 239.4321f, 239.46184f,
+    239.4916f, 239.52132f, 239.55104f, 239.58078f, 239.6105f, 239.64023f, 239.66992f, 239.69963f,
+    239.72934f, 239.75903f, 239.78873f, 239.81842f, 239.8481f, 239.87776f, 239.90744f, 239.93712f,
+    239.96678f, 239.99643f, 240.02608f, 240.05574f, 240.08537f, 240.11502f, 240.14465f, 240.17427f,
+    240.20392f, 240.23354f, 240.26314f, 240.29276f, 240.32236f, 240.35197f, 240.38155f, 240.41115f,
+    240.44073f, 240.4703f, 240.4999f, 240.52946f, 240.55902f, 240.5886f, 240.61815f, 240.6477f,
+    240.67723f, 240.70679f, 240.73633f, 240.76585f, 240.7954f, 240.8249f, 240.85442f, 240.88396f,
+    240.91345f, 240.94296f, 240.97246f, 241.00197f, 241.03145f, 241.06093f, 241.0904f, 241.11987f,
+    241.14937f, 241.17882f, 241.20828f, 241.23773f, 241.26718f, 241.29665f, 241.3261f, 241.35553f,
+    241.38495f, 241.41438f, 241.4438f, 241.47322f, 241.50262f, 241.53204f, 241.56145f, 241.59084f,
+    241.62024f, 241.64963f, 241.67903f, 241.70839f, 241.73778f, 241.76715f, 241.79651f, 241.82588f,
+    241.85521f, 241.88458f, 241.91394f, 241.94328f, 241.97261f, 242.00195f, 242.03128f, 242.06061f,
+    242.08992f, 242.11922f, 242.14856f, 242.17786f, 242.20717f, 242.23643f, 242.26575f, 242.29501f,
+    242.3243f, 242.35359f, 242.38287f, 242.41214f, 242.44139f, 242.47063f, 242.49991f, 242.52914f,
+    242.5584f, 242.58763f, 242.61688f, 242.64609f, 242.67532f, 242.70454f, 242.73375f, 242.76297f,
+    242.79218f, 242.8214f, 242.8506f, 242.87979f, 242.90897f, 242.93816f, 242.96733f, 242.99652f,
+    243.02567f, 243.05486f, 243.084f, 243.11316f, 243.1423f, 243.17146f, 243.2006f, 243.22974f,
+    243.25887f, 243.28801f, 243.31714f, 243.34625f, 243.37535f, 243.40446f, 243.43356f, 243.46268f,
+    243.49178f, 243.52086f, 243.54996f, 243.57904f, 243.60811f, 243.63716f, 243.66626f, 243.69531f,
+    243.72438f, 243.75343f, 243.78247f, 243.81152f, 243.84056f, 243.86963f, 243.89862f, 243.92766f,
+    243.95668f, 243.98572f, 244.01471f, 244.04375f, 244.07271f, 244.10175f, 244.1307f, 244.15971f,
+    244.18872f, 244.21768f, 244.24666f, 244.27562f, 244.30463f, 244.33356f, 244.36253f, 244.3915f,
+    244.42044f, 244.44939f, 244.47832f, 244.50726f, 244.5362f, 244.56511f, 244.59404f, 244.62296f,
+    244.65187f, 244.68077f, 244.70969f, 244.73859f, 244.76747f, 244.79637f, 244.82526f, 244.85414f,
+    244.88301f, 244.9119f, 244.94077f, 244.96962f, 244.99849f, 245.02734f, 245.0562f, 245.08504f,
+    245.11386f, 245.1427f, 245.17155f, 245.20038f, 245.22919f, 245.25801f, 245.28682f, 245.31564f,
+    245.34444f, 245.37325f, 245.40204f, 245.43085f, 245.45961f, 245.4884f, 245.51718f, 245.54597f,
+    245.57472f, 245.60349f, 245.63228f, 245.661f, 245.68979f, 245.7185f, 245.74727f, 245.776f,
+    245.80472f, 245.83348f, 245.86217f, 245.8909f, 245.91963f, 245.94835f, 245.97705f, 246.00575f,
+    246.03444f, 246.06314f, 246.09183f, 246.1205f, 246.1492f, 246.17786f, 246.20653f, 246.23523f,
+    246.26389f, 246.29253f, 246.32118f, 246.34985f, 246.3785f, 246.40712f, 246.43576f, 246.4644f,
+    246.49303f, 246.52164f, 246.55028f, 246.57887f, 246.60751f, 246.63612f, 246.66469f, 246.6933f,
+    246.72191f, 246.75047f, 246.77905f, 246.80765f, 246.83623f, 246.86478f, 246.89334f, 246.92192f,
+    246.95047f, 246.97903f, 247.00758f, 247.03613f, 247.06467f, 247.09322f, 247.12173f, 247.15024f,
+    247.17879f, 247.2073f, 247.23581f, 247.26433f, 247.29282f, 247.32132f, 247.34984f, 247.37833f,
+    247.4068f, 247.43529f, 247.46378f, 247.49223f, 247.5207f, 247.54916f, 247.57765f, 247.6061f,
+    247.63455f, 247.66301f, 247.69142f, 247.71988f, 247.74834f, 247.77675f, 247.80518f, 247.8336f,
+    247.86201f, 247.89044f, 247.91884f, 247.94727f, 247.97565f, 248.00404f, 248.03244f, 248.06082f,
+    248.08922f, 248.11758f, 248.14598f, 248.17433f, 248.2027f, 248.23106f, 248.25945f, 248.28778f,
+    248.31615f, 248.34447f, 248.37283f, 248.40117f, 248.4295f, 248.45782f, 248.48613f, 248.51447f,
+    248.5428f, 248.57109f, 248.5994f, 248.6277f, 248.65599f, 248.6843f, 248.7126f, 248.74088f,
+    248.76913f, 248.79744f, 248.82571f, 248.85399f, 248.88225f, 248.91049f, 248.93877f, 248.96701f,
+    248.99527f, 249.02348f, 249.05173f, 249.07996f, 249.1082f, 249.13644f, 249.16466f, 249.19286f,
+    249.22107f, 249.24928f, 249.2775f, 249.3057f, 249.33388f, 249.36209f, 249.39027f, 249.41844f,
+    249.44662f, 249.47481f, 249.50299f, 249.53117f, 249.55931f, 249.58746f, 249.61562f, 249.64377f,
+    249.6719f, 249.70006f, 249.72818f, 249.75633f, 249.78444f, 249.81259f, 249.84071f, 249.86884f,
+    249.89693f, 249.92503f, 249.95316f, 249.98125f, 250.00937f, 250.03741f, 250.0655f, 250.0936f,
+    250.12169f, 250.14975f, 250.17783f, 250.20589f, 250.23395f, 250.26201f, 250.29005f, 250.31812f,
+    250.34618f, 250.3742f, 250.40224f, 250.43028f, 250.45831f, 250.48634f, 250.51434f, 250.54237f,
+    250.57036f, 250.59839f, 250.62639f, 250.65439f, 250.68239f, 250.71037f, 250.73837f, 250.76634f,
+    250.79434f, 250.82231f, 250.85027f, 250.87823f, 250.9062f, 250.93417f, 250.96211f, 250.99008f,
+    251.018f, 251.04594f, 251.07388f, 251.10182f, 251.12976f, 251.15768f, 251.1856f, 251.21353f,
+    251.24144f, 251.26935f, 251.29726f, 251.32515f, 251.35306f, 251.38094f, 251.40881f, 251.43672f,
+    251.4646f, 251.49246f, 251.52034f, 251.54822f, 251.57607f, 251.60394f, 251.63179f, 251.65962f,
+    251.68747f, 251.71532f, 251.74316f, 251.77101f, 251.79883f, 251.82668f, 251.85448f, 251.8823f,
+    251.91011f, 251.93793f, 251.96574f, 251.99356f, 252.02135f, 252.04912f, 252.07693f, 252.10472f,
+    252.13248f, 252.16026f, 252.18805f, 252.21584f, 252.24358f, 252.27133f, 252.29912f, 252.32684f,
+    252.3546f, 252.38235f, 252.41008f, 252.43782f, 252.46558f, 252.4933f, 252.52103f, 252.54875f,
+    252.57645f, 252.60417f, 252.6319f, 252.65958f, 252.68727f, 252.71497f, 252.74266f, 252.77036f,
+    252.79805f, 252.82574f, 252.85341f, 252.8811f, 252.90875f, 252.93642f, 252.96408f, 252.99174f,
+    253.01938f, 253.04704f, 253.07468f, 253.10234f, 253.12997f, 253.15761f, 253.18523f, 253.21286f,
+    253.24046f, 253.2681f, 253.2957f, 253.32333f, 253.3509f, 253.37851f, 253.40611f, 253.43372f,
+    253.4613f, 253.48888f, 253.51645f, 253.54405f, 253.57162f, 253.5992f, 253.62674f, 253.65431f,
+    253.68185f, 253.70943f, 253.73697f, 253.76451f, 253.79204f, 253.81958f, 253.84712f, 253.87466f,
+    253.90218f, 253.92969f, 253.95723f, 253.98474f, 254.01225f, 254.03976f, 254.06725f, 254.09476f,
+    254.12227f, 254.14975f, 254.17722f, 254.2047f, 254.23218f, 254.25966f, 254.28711f, 254.31459f,
+    254.34207f, 254.36952f, 254.39697f, 254.42442f, 254.45187f, 254.47932f, 254.50677f, 254.5342f,
+    254.56161f, 254.58907f, 254.61649f, 254.6439f, 254.67128f, 254.6987f, 254.72612f, 254.75351f,
+    254.78093f, 254.80832f, 254.83571f, 254.8631f, 254.89049f, 254.91788f, 254.94524f, 254.97263f,
+    254.99998f,
 };
 
+// sRGB encoding of linear light in [0, 1] to 0-255, interpolated in
+// LINEAR_TO_SRGB, within 0.01 of the exact curve. Values outside [0, 1] take
+// the exact curve instead, so they still come out of range and Rgb reports them
+constexpr float linear_to_srgb(float c)
+{
+    if (!(c >= 0 && c < 1))
+        return srgb_encode(c);
+
+    float const pos = c * (LINEAR_TO_SRGB.size() - 1);
+    int const i = static_cast<int>(pos);
+    return LINEAR_TO_SRGB[i] + (pos - i) * (LINEAR_TO_SRGB[i + 1] - LINEAR_TO_SRGB[i]);
+}
+
 // =========== okLAB Space ==========
 
-inline Lab::Lab(float l, float a, float b)
+constexpr Lab::Lab(float l, float a, float b)
     : Color(l, a, b)
 {
 }
 
-inline Rgb Lab::to_rgb() const
+// linear sRGB of an OkLab color, out of gamut values as they are
+constexpr std::array<float, 3> oklab_to_linear_srgb(float L, float a, float b)
 {
-    auto [L, a, b] = m_values;
-
     float l_ = L + 0.3963377774f * a + 0.2158037573f * b;
     float m_ = L - 0.1055613458f * a - 0.0638541728f * b;
     float s_ = L - 0.0894841775f * a - 1.2914855480f * b;
@@ -89,43 +748,126 @@ inline Rgb Lab::to_rgb() const
     float g1 = -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s;
     float b1 = -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s;
 
-    return Rgb(r1, g1, b1);
+    return { r1, g1, b1 };
 }
 
-inline void Lab::print() const
+constexpr bool in_linear_gamut(std::array<float, 3> const& linear)
 {
-    std::cout << "[Lab]" << "\nL: " << m_values[0] << "\na: " << m_values[1]
-              << "\nb: " << m_values[2] << "\n\n";
+    constexpr float tolerance = 1e-5f;
+    for (float const c : linear) {
+        if (c < -tolerance || c > 1 + tolerance)
+            return false;
+    }
+    return true;
 }
 
-// ========== sRGB Space ==========
+// bisection steps for the chroma scale in to_rgb_in_gamut, 2^-16 of the
+// original chroma is well below a step of one 8 bit channel
+inline constexpr int GAMUT_STEPS = 16;
 
-inline Rgb::Rgb(float r, float g, float b)
-    : Color(static_cast<uchar>(std::clamp(std::lround(r), 0l, 255l)),
-          static_cast<uchar>(std::clamp(std::lround(g), 0l, 255l)),
-          static_cast<uchar>(std::clamp(std::lround(b), 0l, 255l)))
+constexpr Rgb Lab::to_rgb() const
 {
+    auto const [r, g, b] = oklab_to_linear_srgb(m_values[0], m_values[1], m_values[2]);
+    return Rgb(linear_to_srgb(r), linear_to_srgb(g), linear_to_srgb(b));
+}
 
-    auto warn_if_clamped = [](float val, char const* name) {
-        if (val < -0.001f || val > 255.001f) {
-            std::cout << "Warning: " << name << " channel clamped: " << val << '\n';
+constexpr Rgb Lab::to_rgb_in_gamut() const
+{
+    auto const [l, a, b] = m_values;
+    // grays are in gamut at any lightness from black to white
+    float const L = std::clamp(l, 0.0f, 1.0f);
+    std::array<float, 3> linear = oklab_to_linear_srgb(L, a, b);
+
+    if (!in_linear_gamut(linear)) {
+        float inside = 0;
+        float outside = 1;
+        for (int i = 0; i < GAMUT_STEPS; ++i) {
+            float const scale = (inside + outside) / 2;
+            if (in_linear_gamut(oklab_to_linear_srgb(L, scale * a, scale * b)))
+                inside = scale;
+            else
+                outside = scale;
         }
-    };
+        linear = oklab_to_linear_srgb(L, inside * a, inside * b);
+    }
 
-    warn_if_clamped(r, "R");
-    warn_if_clamped(g, "G");
-    warn_if_clamped(b, "B");
+    // what's left outside [0, 1] is rounding, so it's clamped without counting
+    auto const [r, g, b_] = linear;
+    return Rgb::unchecked(linear_to_srgb(r), linear_to_srgb(g), linear_to_srgb(b_));
 }
 
-inline Lab Rgb::to_lab() const
+inline void print(Lab const& color)
 {
-    float l = 0.4122214708f * r() + 0.5363325363f * g() + 0.0514459929f * b();
-    float m = 0.2119034982f * r() + 0.6806995451f * g() + 0.1073969566f * b();
-    float s = 0.0883024619f * r() + 0.2817188376f * g() + 0.6299787005f * b();
+    auto const [l, a, b] = color.get_values();
+    std::cout << "[Lab]" << "\nL: " << l << "\na: " << a << "\nb: " << b << "\n\n";
+}
+
+// ========== sRGB Space ==========
+
+constexpr uchar clamp_channel(float c)
+{
+    // rounds halves up like std::lround, which isn't constexpr; NaN gives 0
+    if (!(c > 0))
+        return 0;
+    return c >= 255 ? 255 : static_cast<uchar>(static_cast<double>(c) + 0.5);
+}
+
+// values that round into 0-255 aren't clamped, which keeps the round-off of
+// converting in-range colors out of the count
+constexpr bool is_clamped(float c) { return c < -0.5f || c > 255.5f; }
+
+// Clamping by Rgb's constructor, summed over every thread. Each thread counts
+// its own without locks or I/O, so a stage that clamps thousands of pixels
+// costs a few increments per pixel and one line at the end of the run.
+struct ClampStats {
+    uint64_t colors = 0;
+    uint64_t channels = 0;
+    // the most extreme clamped values; infinity and -infinity while none were
+    float lowest = std::numeric_limits<float>::infinity();
+    float highest = -std::numeric_limits<float>::infinity();
+};
+
+// counts a color the constructor clamped on the calling thread. Out of line,
+// so the constructor stays usable in constant expressions
+void record_clamp(float r, float g, float b);
+
+ClampStats clamp_stats();
 
-    float l_ = cbrtf(l);
-    float m_ = cbrtf(m);
-    float s_ = cbrtf(s);
+// one warning line, if anything was clamped
+void print_clamp_stats(std::ostream& os = std::cout);
+
+constexpr Rgb::Rgb(float r, float g, float b)
+    : Color(clamp_channel(r), clamp_channel(g), clamp_channel(b))
+{
+    if (is_clamped(r) || is_clamped(g) || is_clamped(b))
+        record_clamp(r, g, b);
+}
+
+constexpr Rgb Rgb::from_bytes(uchar r, uchar g, uchar b)
+{
+    Rgb rgb {};
+    rgb.m_values = { r, g, b };
+    return rgb;
+}
+
+constexpr Rgb Rgb::unchecked(float r, float g, float b)
+{
+    return from_bytes(clamp_channel(r), clamp_channel(g), clamp_channel(b));
+}
+
+constexpr Lab Rgb::to_lab() const
+{
+    float r_lin = SRGB_TO_LINEAR[m_values[0]];
+    float g_lin = SRGB_TO_LINEAR[m_values[1]];
+    float b_lin = SRGB_TO_LINEAR[m_values[2]];
+
+    float l = 0.4122214708f * r_lin + 0.5363325363f * g_lin + 0.0514459929f * b_lin;
+    float m = 0.2119034982f * r_lin + 0.6806995451f * g_lin + 0.1073969566f * b_lin;
+    float s = 0.0883024619f * r_lin + 0.2817188376f * g_lin + 0.6299787005f * b_lin;
+
+    float l_ = cube_root(l);
+    float m_ = cube_root(m);
+    float s_ = cube_root(s);
 
     return {
         0.2104542553f * l_ + 0.7936177850f * m_ - 0.0040720468f * s_,
@@ -134,10 +876,25 @@ inline Lab Rgb::to_lab() const
     };
 }
 
-inline void Rgb::print() const
+inline void print(Rgb const& color)
 {
-    std::cout << "[Rgb]" << "\nr: " << (int)m_values[0] << "\ng: " << (int)m_values[1]
-              << "\nb: " << (int)m_values[2] << std::endl;
+    auto const [r, g, b] = color.get_values();
+    std::cout << "[Rgb]" << "\nr: " << (int)r << "\ng: " << (int)g << "\nb: " << (int)b
+              << std::endl;
 }
 
+// ========== Layout ==========
+
+static_assert(std::is_trivial_v<Lab> && std::is_standard_layout_v<Lab>);
+static_assert(std::is_trivial_v<Rgb> && std::is_standard_layout_v<Rgb>);
+static_assert(sizeof(Lab) == 3 * sizeof(float) && sizeof(Rgb) == 3);
+
+// the conversions run at compile time too
+static_assert(Rgb(255, 255, 255).to_lab().l() > 0.999f);
+static_assert(Lab(1, 0, 0).to_rgb().r() == 255 && Lab(1, 0, 0).to_rgb().b() == 255);
+// a green far outside sRGB keeps its lightness and hue, only chroma is lost
+inline constexpr Lab MAPPED_GREEN = Lab(0.5f, -0.3f, 0).to_rgb_in_gamut().to_lab();
+static_assert(MAPPED_GREEN.l() > 0.49f && MAPPED_GREEN.l() < 0.51f && MAPPED_GREEN.a() < -0.05f
+    && MAPPED_GREEN.b() > -0.005f && MAPPED_GREEN.b() < 0.005f);
+
 } // namespace clrspc
@@ -1,7 +1,19 @@
 #pragma once
 
 #include "../include/Bitmap.h"
+#include "../include/util.h"
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
-void createAtlasPic(const std::vector<Bitmap> &validTextures);
+// pixels each texture takes up in the atlas, whatever the block size
+constexpr int ATLAS_TILE_PIXELS = 256;
+
+// how many times the atlas scales up textures of blockSize pixels, at least 1
+inline int atlasZoom(int blockSize) { return std::max(1, ATLAS_TILE_PIXELS / blockSize); }
+
+// saves every texture on a square grid, zoomed by atlasZoom(blockSize)
+void createAtlasPic(const std::vector<Bitmap> &validTextures,
+                    const int blockSize = BLOCK_SIZE,
+                    const std::string &outPath = "./outputPics/atlasPic.png");
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Bitmap.h"
+#include "Color_Space.h"
+#include "mosaicConfig.h"
+#include "rawImage.h"
+
+#include <string>
+#include <vector>
+
+// Expands the command line inputs into the list of images to process.
+// Directories contribute every .png directly inside them, in name order, with
+// the extension in any case. Throws std::invalid_argument when two inputs share
+// a file stem, since their outputs would overwrite each other.
+std::vector<std::string> collectBatchInputs(std::vector<std::string> const& args);
+
+// outDir/<stem>_textured<ext>
+std::string batchOutputPath(
+    std::string const& inputPath, std::string const& outDir, OutputFormat format);
+
+// Builds a textured mosaic for every input, reusing the already loaded
+// textures and their averages. Decoding, lookup and encoding run on their own
+// threads connected by short bounded queues, so the next image is decoded while
+// the current one is matched and the previous one is written, without more than
+// a few images in memory at once. A failing image is reported on stderr and
+// skipped. Returns the number of images that failed.
+int runBatch(std::vector<std::string> const& inputs, std::string const& outDir,
+    OutputFormat format, std::vector<Bitmap> const& validTextures,
+    std::vector<clrspc::Lab> const& textureAvgColors, MosaicConfig const& config);
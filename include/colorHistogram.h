@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Bitmap.h"
+#include "Color_Space.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#if __cplusplus > 201703L && __has_include(<bit>)
+#    include <bit>
+#endif
+
+// One occupied bin of a color histogram
+struct ColorBin {
+    // mean color of the pixels in the bin
+    clrspc::Lab color;
+    uint32_t count;
+};
+
+// 0xRRGGBB, the key of every exact color lookup
+inline uint32_t packRgb(uchar const* px)
+{
+    return (uint32_t(px[0]) << 16) | (uint32_t(px[1]) << 8) | px[2];
+}
+
+inline clrspc::Rgb unpackRgb(uint32_t rgb)
+{
+    return clrspc::Rgb::from_bytes(rgb >> 16, (rgb >> 8) & 0xFF, rgb & 0xFF);
+}
+
+// set bits of a 64 bit word
+inline int popcount64(uint64_t bits)
+{
+#if defined(__cpp_lib_bitops)
+    return std::popcount(bits);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    bits -= (bits >> 1) & 0x5555555555555555;
+    bits = (bits & 0x3333333333333333) + ((bits >> 2) & 0x3333333333333333);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0F;
+    return static_cast<int>((bits * 0x0101010101010101) >> 56);
+#endif
+}
+
+// index of the lowest set bit, bits must not be 0
+inline int countTrailingZeros64(uint64_t bits)
+{
+#if defined(__cpp_lib_bitops)
+    return std::countr_zero(bits);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    return popcount64((bits & (~bits + 1)) - 1);
+#endif
+}
+
+// Every distinct color of a bitmap. Whatever the image, that's a bitset over
+// all 2^24 colors and the number of colors before each of its 64 bit words,
+// 3 MB that mostly stay in cache, where a hash map would grow with the colors.
+// A color's position among the distinct ones is then a popcount away.
+struct DistinctColors {
+    static constexpr size_t NUM_WORDS = (size_t(1) << 24) / 64;
+
+    // one bit per packed color, set for the ones that occur. Atomic so the
+    // rows can be marked in parallel
+    std::vector<std::atomic<uint64_t>> present;
+    // set bits in the words of present before each one
+    std::vector<uint32_t> rank;
+    // packed colors in RGB order
+    std::vector<uint32_t> colors;
+
+    // position of rgb in colors. rgb must occur in the bitmap
+    uint32_t indexOf(uint32_t rgb) const
+    {
+        uint64_t const word = present[rgb >> 6].load(std::memory_order_relaxed);
+        return rank[rgb >> 6] + popcount64(word & ((uint64_t(1) << (rgb & 63)) - 1));
+    }
+};
+
+// Chunks of rows mark their colors in parallel. Work that only depends on
+// which colors occur can then run once per color instead of once per pixel.
+DistinctColors findDistinctColors(Bitmap const& bitmap);
+
+// Counts the bitmap's colors in bins of the top bitsPerChannel bits of each
+// channel, 1 to 6. Work that only depends on which colors occur, and how
+// often, can then run over at most 2^(3 * bitsPerChannel) bins instead of
+// every pixel. Chunks of rows fill histograms of their own in parallel.
+// Bins are returned in RGB order, empty ones left out.
+std::vector<ColorBin> buildColorHistogram(Bitmap const& bitmap, int bitsPerChannel = 5);
+
+// One bin per distinct color, in RGB order, counted exactly
+std::vector<ColorBin> buildExactColorHistogram(Bitmap const& bitmap);
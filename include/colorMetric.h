@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Color_Space.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+// How the difference between two colors is measured when matching to a palette.
+//   OkLab:          squared Euclidean distance in OkLab
+//   WeightedOkLab:  the same with lightness differences counting twice as much,
+//                   which keeps shading at the cost of some hue accuracy
+//   Ciede2000:      CIE Delta E 2000 in CIELAB (D65). Costs far more per pair,
+//                   so it only decides between the nearest palette entries in
+//                   OkLab
+//   Cam16Ucs:       Euclidean distance in CAM16-UCS, under average surround
+//                   with a 20% gray background at 64 lux
+enum class ColorMetric { OkLab, WeightedOkLab, Ciede2000, Cam16Ucs };
+
+// Accepts "oklab", "weighted_oklab", "ciede2000" and "cam16_ucs"
+ColorMetric parseColorMetric(std::string const& name);
+
+// palette entries, nearest in OkLab, that CIEDE2000 decides between. With the
+// texture palette that's the exhaustive CIEDE2000 match for most colors, and
+// within 0.3 of its mean Delta E, at 1/28 the cost (metricBench)
+constexpr int METRIC_CANDIDATES = 8;
+
+// Finds the closest palette entry to colors under a metric. The palette is
+// converted to the metric's space once, so every match only converts the
+// color it's given. Euclidean metrics search the whole palette there.
+// CIEDE2000 first takes the exact candidates nearest entries in OkLab, then
+// compares the color with those only; 0 candidates compares it with all.
+class ColorMatcher {
+public:
+    ColorMatcher(std::vector<clrspc::Lab> const& palette, ColorMetric metric,
+        int candidates = METRIC_CANDIDATES);
+
+    // index into the palette
+    size_t closest(clrspc::Lab const& color) const;
+
+private:
+    std::array<float, 3> toMetricSpace(clrspc::Lab const& color) const;
+
+    std::vector<clrspc::Lab> m_palette;
+    ColorMetric m_metric;
+    int m_candidates;
+    // the palette in the metric's space: weighted OkLab, CIELAB or CAM16-UCS
+    std::vector<std::array<float, 3>> m_points;
+};
+
+// CIELAB under D65 of an OkLab color
+std::array<float, 3> toCieLab(clrspc::Lab const& color);
+
+// CAM16-UCS J', a', b' of an OkLab color
+std::array<float, 3> toCam16Ucs(clrspc::Lab const& color);
+
+// CIE Delta E 2000 between two CIELAB colors
+float ciede2000(std::array<float, 3> const& lab1, std::array<float, 3> const& lab2);
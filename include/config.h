@@ -2,11 +2,13 @@
 
 #include <cstddef> // for size_t
 
+// Compile-time defaults, each can be overridden at runtime, see mosaicConfig.h
+
 // Texture filtering threshold.
 // Higher values allow more variation within a texture tile.
 // Lower values enforce stricter uniformity (less noisy textures).
-// DELETE texture.dat file after changing this setting
-constexpr float DIFF_THRESHOLD = 35.5f; // about [1-100]
+// texture.dat is rebuilt automatically when this changes
+constexpr float DIFF_THRESHOLD = 1.8f; // about [0.05-5]
 
 // Gaussian blur radius for preprocessing
 // Higher for more blur
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Bitmap.h"
+#include "Color_Space.h"
+#include "colorMetric.h"
+
+#include <string>
+#include <vector>
+
+// How buildDitheredLookupTable hides the banding of a small palette.
+//   None:        every pixel matched on its own, like buildLookupTable
+//   FloydSteinberg, SierraLite, Jarvis:
+//                error diffusion, the matching error of every pixel is spread
+//                over its not yet matched neighbors
+//   Bayer:       ordered dithering with an 8x8 Bayer matrix
+//   BlueNoise:   ordered dithering with a 64x64 blue-noise texture, without
+//                the Bayer cross-hatch
+enum class DitherMethod { None, FloydSteinberg, SierraLite, Jarvis, Bayer, BlueNoise };
+
+// Accepts "none", "floyd_steinberg", "sierra_lite", "jarvis", "bayer" and
+// "blue_noise"
+DitherMethod parseDitherMethod(std::string const& name);
+
+// Lookup table of the closest quantColors entry under metric for every bitmap
+// pixel, like buildLookupTable, dithered in OkLab.
+//
+// Ordered dithering offsets every pixel by its threshold, scaled to the
+// palette's typical spacing, before the match. Pixels stay independent, so it
+// costs about as much as buildLookupTable.
+//
+// Error diffusion runs its rows on all cores as a wavefront: a row starts once
+// the row above is a few pixels ahead, far enough that every error reaching
+// the current pixel is already in place. Each row keeps its incoming errors
+// apart by the row they come from, so the result is the same for any number
+// of threads.
+std::vector<std::vector<int>> buildDitheredLookupTable(Bitmap const& bitmap,
+    std::vector<clrspc::Lab> const& quantColors, DitherMethod method,
+    ColorMetric metric = ColorMetric::OkLab);
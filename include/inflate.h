@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using uchar = std::uint8_t;
+
+// Table-driven inflate (RFC 1951) for the decoder's hot path. Decodes a raw
+// deflate stream and appends it to out, reading bits 64 at a time and most
+// Huffman codes with a single table lookup where lodepng walks the code tree
+// bit by bit. sizeHint is the expected output size when known, so the output
+// grows once instead of repeatedly. Returns false on malformed or truncated input.
+bool inflateRaw(uchar const* in, size_t size, std::vector<uchar>& out, size_t sizeHint = 0);
@@ -787,6 +787,16 @@ unsigned lodepng_deflate(unsigned char** out, size_t* outsize,
                          const unsigned char* in, size_t insize,
                          const LodePNGCompressSettings* settings);
 
+/*
+Like lodepng_deflate, but the last block is not marked final and the output ends
+with an empty stored block (a zlib "sync flush"), so separately compressed parts
+can be concatenated into one deflate stream. The last part must be compressed
+with lodepng_deflate. Local addition, not part of upstream LodePNG.
+*/
+unsigned lodepng_deflate_flush(unsigned char** out, size_t* outsize,
+                               const unsigned char* in, size_t insize,
+                               const LodePNGCompressSettings* settings);
+
 #endif /*LODEPNG_COMPILE_ENCODER*/
 #endif /*LODEPNG_COMPILE_ZLIB*/
 
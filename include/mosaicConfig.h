@@ -0,0 +1,46 @@
+#pragma once
+
+#include "colorMetric.h"
+#include "config.h"
+#include "dither.h"
+#include "util.h"
+
+#include <string>
+
+// Settings that can change from run to run without a rebuild. The defaults
+// are the compile-time constants from config.h and util.h.
+//
+// In a config file or on the command line:
+//   diff_threshold  --diff-threshold  texture uniformity, see config.h
+//   blur_radius     --blur-radius     Gaussian blur radius, 0 to skip the blur
+//   block_size      --block-size      pixels per mosaic tile, textures are resampled to it
+//   resize_factor   --resize-factor   shrink factor before matching, in (0, 1]
+//   textures_dir    --textures-dir    directory of texture PNGs
+//   texture_cache   --texture-cache   where the valid textures and their averages are cached
+//   dither          --dither          none, floyd_steinberg, sierra_lite, jarvis, bayer or blue_noise
+//   metric          --metric          oklab, weighted_oklab, ciede2000 or cam16_ucs, see colorMetric.h
+//   palette_size    --palette-size    colors generated from the image for --mode quantized, 0 for the
+//                                     fixed grid
+struct MosaicConfig {
+    float diffThreshold = DIFF_THRESHOLD;
+    int blurRadius = GAUSSIAN_BLUR_RADIUS;
+    int blockSize = BLOCK_SIZE;
+    // 0 shrinks by 1 / blockSize, which keeps the mosaic the size of the input
+    float resizeFactor = 0;
+    std::string texturesDir = "./blocks";
+    std::string textureCachePath = "texture.dat";
+    DitherMethod dither = DitherMethod::None;
+    ColorMetric metric = ColorMetric::OkLab;
+    // up to 256; 0 quantizes to the fixed 9x9x9 RGB grid instead
+    int paletteSize = 0;
+
+    float effectiveResizeFactor() const { return resizeFactor > 0 ? resizeFactor : 1.f / blockSize; }
+};
+
+// Sets the setting named by its config file key. Throws std::invalid_argument
+// for an unknown key or a value that is malformed or out of range.
+void setConfigValue(MosaicConfig& config, std::string const& key, std::string const& value);
+
+// Applies every "key = value" line of the file. Blank lines and lines starting
+// with # are skipped.
+void loadConfigFile(MosaicConfig& config, std::string const& path);
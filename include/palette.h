@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Bitmap.h"
+#include "Color_Space.h"
+#include "colorHistogram.h"
+
+#include <vector>
+
+// Picks numColors colors that represent the histogram well, weighted by how
+// often each color occurs. Median cut in OkLab gives the starting palette,
+// which weighted k-means then refines until it stops moving. Returns fewer
+// colors when the histogram has fewer bins.
+std::vector<clrspc::Lab> generatePalette(std::vector<ColorBin> const& histogram, int numColors);
+
+// Same, for the colors of a bitmap reduced to a 5 bit per channel histogram
+std::vector<clrspc::Lab> generatePalette(Bitmap const& bitmap, int numColors);
@@ -2,6 +2,7 @@
 
 #include "Bitmap.h"
 #include "lodepng.h"
+#include "pngEncoder.h"
 
 #include <string>
 #include <vector>
@@ -10,6 +11,8 @@
 class Picture {
 public:
   explicit Picture(const std::string &filename);
+  // decodes a PNG file that is already in memory
+  explicit Picture(const std::vector<unsigned char> &pngFile);
   explicit Picture(const std::vector<std::vector<int>> &grays);
   Picture(const Bitmap &bitmap, const int factor = 1);
   Picture(int width, int height, int red = 0, int green = 0, int blue = 0,
@@ -23,7 +26,8 @@ public:
   int alpha(int x, int y) const;
 
   void set(int x, int y, int red, int green, int blue, int alpha = 255);
-  void save(const std::string &filename) const;
+  void save(const std::string &filename,
+            PngProfile profile = PngProfile::Balanced) const;
   Picture bilinearResize(float factor) const;
   Bitmap getBitmap() const;
   void gaussianBlur(const size_t strength);
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Bitmap.h"
+
+#include <string>
+#include <vector>
+
+// Decodes a PNG into 8-bit pixels with 3 (RGB) or 4 (RGBA) channels.
+//
+// Non-interlaced 8-bit RGB and RGBA files take a fast path that unfilters each
+// scanline and converts it straight into the requested layout in one pass,
+// instead of decoding to RGBA and converting again afterwards. When every IDAT
+// chunk but the last ends on a sync flush, as encodePng writes them, the chunks
+// are inflated on separate threads. Anything else goes through lodepng.
+void decodePng(std::string const& filename, std::vector<uchar>& pixels, int& width, int& height,
+    int channels);
+
+// Same, for a PNG file already in memory
+void decodePng(std::vector<uchar> const& file, std::vector<uchar>& pixels, int& width, int& height,
+    int channels);
+
+// Decodes straight into the pipeline's RGB working format
+Bitmap decodePngBitmap(std::string const& filename);
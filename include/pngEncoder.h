@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using uchar = std::uint8_t;
+
+// PNG color types written by the encoder, values as in the PNG spec
+enum class PngColorType : uchar { Rgb = 2, Palette = 3, Rgba = 6 };
+
+// RGB entries of a PLTE chunk, at most 256
+using PngPalette = std::vector<std::array<uchar, 3>>;
+
+// Trade-off between encode time and file size
+//   Fastest:  no filtering, fixed Huffman codes and greedy matches in a window
+//             that just reaches the scanline above
+//   Balanced: adaptive per-row filters and lodepng's default deflate settings
+//   Smallest: adaptive filters with the full 32K window and longest matches
+enum class PngProfile { Fastest, Balanced, Smallest };
+
+// Writes the unfiltered bytes of scanline y into row. Called concurrently from
+// several threads with arbitrary y, so it must not depend on call order.
+using ScanlineSource = std::function<void(int y, uchar* row)>;
+
+// Splits the image into horizontal stripes that are filtered and deflated on
+// separate threads, then stitched into a single zlib stream. Every stripe but
+// the last ends with a sync flush so the stripes concatenate into valid deflate
+// data, the same way pigz parallelizes gzip.
+// Palette images take one index byte per pixel and need a palette.
+void encodePng(std::string const& filename, int width, int height, PngColorType colorType,
+    ScanlineSource const& source, PngProfile profile = PngProfile::Balanced,
+    PngPalette const& palette = {});
+
+// Same, writing the PNG file to a stream
+void encodePng(std::ostream& os, int width, int height, PngColorType colorType,
+    ScanlineSource const& source, PngProfile profile = PngProfile::Balanced,
+    PngPalette const& palette = {});
+
+// Writes an image where every entry of indices becomes a factor x factor square
+// of that palette color, straight from the table without building the pixels.
+// Uses an 8-bit palette image when at most 256 entries are referenced and
+// falls back to 24-bit RGB otherwise.
+void encodeIndexedPng(std::string const& filename, std::vector<std::vector<int>> const& indices,
+    PngPalette const& palette, int factor, PngProfile profile = PngProfile::Balanced);
+
+// Shared with the decoder
+int paethPredictor(int a, int b, int c);
+unsigned updateAdler32(unsigned adler, uchar const* data, size_t length);
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "../include/Bitmap.h"
+#include "../include/mosaicConfig.h"
 
+#include <string>
 #include <vector>
 
-void createQuantizedPic(const Bitmap &bitmapIn);
+// Quantizes to config.paletteSize colors picked from the image, or to a fixed
+// grid of colors when it's 0, and writes blocks of config.blockSize pixels
+void createQuantizedPic(
+    const Bitmap &bitmapIn, const MosaicConfig &config = {},
+    const std::string &outPath = "./outputPics/quantizedPic.png");
 
 const std::vector<clrspc::Rgb> endesgaPalette = {
     {190, 74, 47},   {215, 118, 67},  {234, 212, 170}, {228, 166, 114},
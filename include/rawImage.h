@@ -0,0 +1,39 @@
+#pragma once
+
+#include "pngEncoder.h"
+
+#include <ostream>
+#include <string>
+
+// Container for finished images
+//   Png:  compressed, see pngEncoder.h
+//   Ppm:  binary PPM (P6), RGB
+//   Pam:  PAM (P7) with TUPLTYPE RGB_ALPHA
+//   Rgba: the bytes "RGBA", width and height as little-endian uint32, then the
+//         pixels as 8-bit RGBA rows with no padding
+enum class OutputFormat { Png, Ppm, Pam, Rgba };
+
+// Accepts "png", "ppm", "pam" and "rgba"
+OutputFormat parseOutputFormat(std::string const& name);
+
+std::string fileExtension(OutputFormat format);
+
+// Channels per pixel of the scanlines an image in format is made from: RGB for
+// PNG and PPM, RGBA otherwise
+int outputChannels(OutputFormat format);
+
+// Keeps Windows from translating newlines in images written to stdout
+void useBinaryStdout();
+
+// Streams an uncompressed image to a file descriptor, pulling scanlines of
+// outputChannels(format) channels from source one band at a time so the whole
+// image is never held in memory.
+void writeRawImage(int fd, int width, int height, OutputFormat format, ScanlineSource const& source);
+
+// Same, writing to a stream
+void writeRawImage(std::ostream& os, int width, int height, OutputFormat format,
+    ScanlineSource const& source);
+
+// Opens path and calls writeRawImage. A path of "-" writes to stdout.
+void saveRawImage(std::string const& path, int width, int height, OutputFormat format,
+    ScanlineSource const& source);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Bitmap.h"
+#include "Color_Space.h"
+#include "mosaicConfig.h"
+
+#include <string>
+#include <vector>
+
+// Serves textured mosaics over a Unix domain socket at socketPath, keeping the
+// textures and their average colors loaded between requests. Every connection
+// is handled on its own thread and may send any number of requests, each a
+// single text line, optionally followed by a PNG file:
+//
+//   render <png|ppm|pam|rgba> path <input path>\n
+//   render <png|ppm|pam|rgba> bytes <size>\n<size bytes of PNG data>
+//
+// and gets back either
+//
+//   ok <size> decode_ms=<t> match_ms=<t> encode_ms=<t> total_ms=<t>\n<size bytes of image>
+//   error <message>\n
+//
+// Only returns if the socket cannot be set up, which is reported by throwing.
+void runServer(std::string const& socketPath, std::vector<Bitmap> const& validTextures,
+    std::vector<clrspc::Lab> const& textureAvgColors, MosaicConfig const& config);
@@ -1,13 +1,49 @@
 #pragma once
 
+#include <ostream>
 #include <string>
 #include <vector>
 
 #include "../include/Bitmap.h"
+#include "../include/mosaicConfig.h"
+#include "../include/rawImage.h"
 #include "../include/util.h"
 
+// Loads the usable textures, resampled to config.blockSize, and their average
+// colors. Which textures are usable is cached in config.textureCachePath and
+// recomputed whenever the texture directory or the threshold changes.
 void getTextureData(std::vector<Bitmap> &validTextures,
-                    std::vector<clrspc::Lab> &textureAvgColors);
+                    std::vector<clrspc::Lab> &textureAvgColors,
+                    const MosaicConfig &config = {});
 
-void createTexturedPic(const std::vector<std::vector<int>> &textureLookupTable,
-                       const std::vector<Bitmap> &validTextures);
+// Blurs and shrinks srcPic in place, then matches every block to the texture
+// with the closest average color
+std::vector<std::vector<int>>
+buildTextureLookupTable(Picture &srcPic,
+                        const std::vector<clrspc::Lab> &textureAvgColors,
+                        const MosaicConfig &config = {});
+
+// Scanline y of the mosaic, copied out of the textures as RGB (channels 3) or
+// RGBA (channels 4). 8, 16, 32 and 64 pixel tiles use kernels compiled for
+// that size, any other size a generic loop.
+ScanlineSource texturedScanlines(const std::vector<std::vector<int>> &textureLookupTable,
+                                 const std::vector<Bitmap> &validTextures,
+                                 const int channels,
+                                 const int blockSize = BLOCK_SIZE);
+
+Picture composeTexturedPic(const std::vector<std::vector<int>> &textureLookupTable,
+                           const std::vector<Bitmap> &validTextures,
+                           const int blockSize = BLOCK_SIZE);
+
+void createTexturedPic(
+    const std::vector<std::vector<int>> &textureLookupTable,
+    const std::vector<Bitmap> &validTextures,
+    const std::string &outPath = "./outputPics/texturedPic.png",
+    const OutputFormat format = OutputFormat::Png,
+    const int blockSize = BLOCK_SIZE);
+
+// Same as createTexturedPic, writing the encoded image to a stream
+void writeTexturedPic(const std::vector<std::vector<int>> &textureLookupTable,
+                      const std::vector<Bitmap> &validTextures,
+                      std::ostream &os, const OutputFormat format,
+                      const int blockSize = BLOCK_SIZE);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../include/Color_Space.h"
+#include "../include/Timer.h"
+#include "../include/colorMetric.h"
 #include "../include/picture.h"
 
 #include <array>
@@ -9,17 +11,18 @@
 #include <vector>
 
 constexpr int BLOCK_SIZE = 16;
-constexpr float ONE_SIXTEENTH = 0.0625f;
 
 float distSquared(clrspc::Lab const& colorA, clrspc::Lab const& colorB);
 
 std::array<float, 3> multiplyMatrix(
     std::array<std::array<float, 3>, 3> const& matrix, std::array<float, 3> const& vector);
 
-clrspc::Lab getAverage(Bitmap const& bitmap, int originX, int originY);
+clrspc::Lab getAverage(
+    Bitmap const& bitmap, int originX, int originY, int blockSize = BLOCK_SIZE);
 
-std::vector<std::vector<int>> buildLookupTable(
-    Bitmap const& bitmap, std::vector<clrspc::Lab> const& quantColors);
+// closest quantColors entry under metric for every bitmap pixel
+std::vector<std::vector<int>> buildLookupTable(Bitmap const& bitmap,
+    std::vector<clrspc::Lab> const& quantColors, ColorMetric metric = ColorMetric::OkLab);
 
 size_t findClosestColorIdx(
     clrspc::Lab const& targetColor, std::vector<clrspc::Lab> const& quantColors);
@@ -29,17 +32,23 @@ template<typename T> auto euclidean_norm(T const xMag, T const yMag)
     return std::sqrt(xMag * xMag + yMag * yMag);
 }
 
-template<typename Func> void process2dInParallel(int height, int width, Func func)
+// splits the rows into one contiguous chunk per core. Every worker records its
+// chunk as a scope named label on a "worker" track of the trace
+template<typename Func>
+void process2dInParallel(int height, int width, Func func, char const* label = "worker")
 {
 
-    static int const NUM_THREADS
-        = std::min(static_cast<int>(std::thread::hardware_concurrency()), height);
-    static int const CHUNK_SIZE = height / NUM_THREADS;
+    int const NUM_THREADS
+        = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), height));
+    int const CHUNK_SIZE = height / NUM_THREADS;
 
     std::vector<std::thread> threads;
 
     for (int t = 0; t < NUM_THREADS; ++t) {
         threads.emplace_back([=]() {
+            Timer::nameThread("worker");
+            Timer timer(label);
+
             int startRow = t * CHUNK_SIZE;
             int endRow = (t == NUM_THREADS - 1) ? height : (t + 1) * CHUNK_SIZE;
 
@@ -0,0 +1,115 @@
+#include "../include/Color_Space.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace clrspc {
+
+// written only by its own thread, read by clamp_stats() from any thread
+struct ThreadClampStats {
+    std::atomic<uint64_t> colors { 0 };
+    std::atomic<uint64_t> channels { 0 };
+    std::atomic<float> lowest { std::numeric_limits<float>::infinity() };
+    std::atomic<float> highest { -std::numeric_limits<float>::infinity() };
+
+    ClampStats load() const
+    {
+        auto const relaxed = std::memory_order_relaxed;
+        return { colors.load(relaxed), channels.load(relaxed), lowest.load(relaxed),
+            highest.load(relaxed) };
+    }
+};
+
+struct ClampRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadClampStats>> threads;
+    // what threads that already exited had clamped, so the list stays as
+    // short as the running threads even when every stage starts new ones
+    ClampStats exited;
+};
+
+ClampRegistry& clampRegistry()
+{
+    static ClampRegistry registry;
+    return registry;
+}
+
+void merge(ClampStats& into, ClampStats const& from)
+{
+    into.colors += from.colors;
+    into.channels += from.channels;
+    into.lowest = std::min(into.lowest, from.lowest);
+    into.highest = std::max(into.highest, from.highest);
+}
+
+// registers with the first clamp of its thread and hands its counts over on
+// thread exit
+struct ThreadClampHolder {
+    std::shared_ptr<ThreadClampStats> stats = std::make_shared<ThreadClampStats>();
+
+    ThreadClampHolder()
+    {
+        ClampRegistry& registry = clampRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(stats);
+    }
+
+    ~ThreadClampHolder()
+    {
+        ClampRegistry& registry = clampRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        merge(registry.exited, stats->load());
+        registry.threads.erase(
+            std::find(registry.threads.begin(), registry.threads.end(), stats));
+    }
+};
+
+void record_clamp(float r, float g, float b)
+{
+    thread_local ThreadClampHolder holder;
+    ThreadClampStats& stats = *holder.stats;
+    auto const relaxed = std::memory_order_relaxed;
+
+    stats.colors.store(stats.colors.load(relaxed) + 1, relaxed);
+    for (float const c : { r, g, b }) {
+        if (!is_clamped(c))
+            continue;
+
+        stats.channels.store(stats.channels.load(relaxed) + 1, relaxed);
+        stats.lowest.store(std::min(stats.lowest.load(relaxed), c), relaxed);
+        stats.highest.store(std::max(stats.highest.load(relaxed), c), relaxed);
+    }
+}
+
+ClampStats clamp_stats()
+{
+    ClampRegistry& registry = clampRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    ClampStats total = registry.exited;
+    for (auto const& stats : registry.threads) {
+        merge(total, stats->load());
+    }
+    return total;
+}
+
+void print_clamp_stats(std::ostream& os)
+{
+    ClampStats const stats = clamp_stats();
+    if (stats.colors == 0)
+        return;
+
+    os << "Warning: clamped " << stats.channels << " channels of " << stats.colors
+       << " colors to 0-255";
+    if (stats.lowest < 0)
+        os << ", lowest " << stats.lowest;
+    if (stats.highest > 255)
+        os << ", highest " << stats.highest;
+    os << '\n';
+}
+
+} // namespace clrspc
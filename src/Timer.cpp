@@ -0,0 +1,405 @@
+#include "../include/Timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// bounds the memory of long-running processes such as the server. Past these,
+// stats are still exact but percentiles and the trace only cover the start
+constexpr size_t MAX_SAMPLES_PER_SCOPE = 1 << 16;
+constexpr size_t MAX_TRACE_EVENTS_PER_THREAD = 1 << 18;
+// trace events kept from threads that already exited, all of them together
+constexpr size_t MAX_EXITED_TRACE_EVENTS = 1 << 20;
+
+struct ScopeStats {
+  int64_t count = 0;
+  int64_t totalNs = 0;
+  int64_t minNs = INT64_MAX;
+  int64_t maxNs = 0;
+  int64_t firstStartNs = INT64_MAX;
+  std::vector<int64_t> samples;
+
+  void add(int64_t startNs, int64_t durationNs) {
+    ++count;
+    totalNs += durationNs;
+    minNs = std::min(minNs, durationNs);
+    maxNs = std::max(maxNs, durationNs);
+    firstStartNs = std::min(firstStartNs, startNs);
+    if (samples.size() < MAX_SAMPLES_PER_SCOPE)
+      samples.push_back(durationNs);
+  }
+
+  void merge(const ScopeStats &other) {
+    count += other.count;
+    totalNs += other.totalNs;
+    minNs = std::min(minNs, other.minNs);
+    maxNs = std::max(maxNs, other.maxNs);
+    firstStartNs = std::min(firstStartNs, other.firstStartNs);
+    samples.insert(samples.end(), other.samples.begin(), other.samples.end());
+  }
+
+  void mergeCapped(const ScopeStats &other) {
+    merge(other);
+    if (samples.size() > MAX_SAMPLES_PER_SCOPE)
+      samples.resize(MAX_SAMPLES_PER_SCOPE);
+  }
+};
+
+// one node of a thread's call tree
+struct ScopeNode {
+  const char *label;
+  int parent;
+  std::vector<int> children;
+  ScopeStats stats;
+};
+
+struct TraceEvent {
+  const char *label;
+  int64_t startNs;
+  int64_t durationNs;
+};
+
+struct ThreadProfile {
+  // only contended while a report is being built
+  std::mutex mutex;
+  int threadId = 0;
+  const char *name = "thread";
+  // node 0 is the root, the scope outside any timer
+  std::vector<ScopeNode> nodes = {{"", -1, {}, {}}};
+  std::vector<int> openNodes = {0};
+  std::vector<TraceEvent> events;
+};
+
+// the trace track of a thread that exited
+struct ExitedTrack {
+  int threadId;
+  const char *name;
+  std::vector<TraceEvent> events;
+};
+
+struct ProfileRegistry {
+  std::mutex mutex;
+  // running threads only. Every process2dInParallel call and server
+  // connection starts new threads, so the ones that exit are folded into
+  // exitedScopes and exitedTracks and dropped from here
+  std::vector<std::shared_ptr<ThreadProfile>> threads;
+  // the call trees of exited threads, merged by label like a thread's own
+  ThreadProfile exitedScopes;
+  std::vector<ExitedTrack> exitedTracks;
+  size_t exitedEvents = 0;
+  int nextThreadId = 0;
+  Clock::time_point globalStart = Clock::now();
+};
+
+ProfileRegistry &profileRegistry() {
+  static ProfileRegistry registry;
+  return registry;
+}
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now().time_since_epoch())
+      .count();
+}
+
+int64_t globalStartNs() {
+  ProfileRegistry &registry = profileRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             registry.globalStart.time_since_epoch())
+      .count();
+}
+
+// adds the subtree under node index of from to node intoIndex of into
+void foldNode(const ThreadProfile &from, int index, ThreadProfile &into,
+              int intoIndex) {
+  for (const int childIndex : from.nodes[index].children) {
+    const ScopeNode &child = from.nodes[childIndex];
+
+    int found = -1;
+    for (const int candidate : into.nodes[intoIndex].children) {
+      if (into.nodes[candidate].label == child.label) {
+        found = candidate;
+        break;
+      }
+    }
+
+    if (found < 0) {
+      found = into.nodes.size();
+      into.nodes.push_back({child.label, intoIndex, {}, {}});
+      into.nodes[intoIndex].children.push_back(found);
+    }
+
+    into.nodes[found].stats.mergeCapped(child.stats);
+    foldNode(from, childIndex, into, found);
+  }
+}
+
+// registers the thread's profile with its first timer and folds it into the
+// registry's exited totals on thread exit, the registry lock first
+struct ThreadProfileHolder {
+  std::shared_ptr<ThreadProfile> profile = std::make_shared<ThreadProfile>();
+
+  ThreadProfileHolder() {
+    ProfileRegistry &registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    profile->threadId = registry.nextThreadId++;
+    registry.threads.push_back(profile);
+  }
+
+  ~ThreadProfileHolder() {
+    ProfileRegistry &registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::lock_guard<std::mutex> profileLock(profile->mutex);
+
+    foldNode(*profile, 0, registry.exitedScopes, 0);
+
+    // threads that never timed anything would only add empty tracks
+    const size_t kept = std::min(profile->events.size(),
+                                 MAX_EXITED_TRACE_EVENTS - registry.exitedEvents);
+    if (kept > 0) {
+      profile->events.resize(kept);
+      registry.exitedTracks.push_back(
+          {profile->threadId, profile->name, std::move(profile->events)});
+      registry.exitedEvents += kept;
+    }
+
+    registry.threads.erase(std::find(registry.threads.begin(),
+                                     registry.threads.end(), profile));
+  }
+};
+
+ThreadProfile &threadProfile() {
+  thread_local ThreadProfileHolder holder;
+  return *holder.profile;
+}
+
+Timer::Timer(const char *label) {
+  ThreadProfile &profile = threadProfile();
+  {
+    std::lock_guard<std::mutex> lock(profile.mutex);
+    const int parent = profile.openNodes.back();
+
+    int node = -1;
+    for (const int child : profile.nodes[parent].children) {
+      if (profile.nodes[child].label == label) {
+        node = child;
+        break;
+      }
+    }
+
+    if (node < 0) {
+      node = profile.nodes.size();
+      profile.nodes.push_back({label, parent, {}, {}});
+      profile.nodes[parent].children.push_back(node);
+    }
+
+    profile.openNodes.push_back(node);
+  }
+
+  m_startNs = nowNs();
+}
+
+Timer::~Timer() {
+  const int64_t endNs = nowNs();
+  ThreadProfile &profile = threadProfile();
+
+  std::lock_guard<std::mutex> lock(profile.mutex);
+  ScopeNode &node = profile.nodes[profile.openNodes.back()];
+  profile.openNodes.pop_back();
+
+  node.stats.add(m_startNs, endNs - m_startNs);
+  if (profile.events.size() < MAX_TRACE_EVENTS_PER_THREAD)
+    profile.events.push_back({node.label, m_startNs, endNs - m_startNs});
+}
+
+void Timer::global() {
+  nameThread("main");
+  ProfileRegistry &registry = profileRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.globalStart = Clock::now();
+}
+
+void Timer::nameThread(const char *name) {
+  ThreadProfile &profile = threadProfile();
+  std::lock_guard<std::mutex> lock(profile.mutex);
+  profile.name = name;
+}
+
+// a scope of the merged call tree; labels are compared by text since the
+// same literal can live at different addresses in different files
+struct MergedScope {
+  std::string label;
+  ScopeStats stats;
+  std::vector<MergedScope> children;
+};
+
+void mergeNode(const ThreadProfile &profile, int index, MergedScope &into) {
+  for (const int childIndex : profile.nodes[index].children) {
+    const ScopeNode &child = profile.nodes[childIndex];
+
+    auto found = std::find_if(
+        into.children.begin(), into.children.end(),
+        [&](const MergedScope &scope) { return scope.label == child.label; });
+    if (found == into.children.end()) {
+      into.children.push_back({child.label, {}, {}});
+      found = into.children.end() - 1;
+    }
+
+    found->stats.merge(child.stats);
+    mergeNode(profile, childIndex, *found);
+  }
+}
+
+// holds the registry lock throughout, so no thread can be folded into the
+// exited totals halfway and counted twice
+MergedScope mergeThreads() {
+  ProfileRegistry &registry = profileRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  MergedScope root;
+
+  mergeNode(registry.exitedScopes, 0, root);
+  for (const auto &profile : registry.threads) {
+    std::lock_guard<std::mutex> profileLock(profile->mutex);
+    mergeNode(*profile, 0, root);
+  }
+
+  return root;
+}
+
+double toMs(int64_t ns) { return ns / 1e6; }
+
+double percentileMs(std::vector<int64_t> &samples, double fraction) {
+  if (samples.empty())
+    return 0;
+  const size_t k = std::min(samples.size() - 1,
+                            static_cast<size_t>(fraction * samples.size()));
+  std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+  return toMs(samples[k]);
+}
+
+size_t maxLabelWidth(const MergedScope &scope, size_t indent) {
+  size_t width = 0;
+  for (const MergedScope &child : scope.children) {
+    width = std::max({width, indent + child.label.size(),
+                      maxLabelWidth(child, indent + 2)});
+  }
+  return width;
+}
+
+void printScopes(std::ostream &os, MergedScope &scope, size_t indent,
+                 size_t labelWidth, double wallMs) {
+  std::sort(scope.children.begin(), scope.children.end(),
+            [](const MergedScope &a, const MergedScope &b) {
+              return a.stats.firstStartNs < b.stats.firstStartNs;
+            });
+
+  for (MergedScope &child : scope.children) {
+    ScopeStats &stats = child.stats;
+    const double totalMs = toMs(stats.totalNs);
+
+    os << std::string(indent, ' ') << std::left
+       << std::setw(labelWidth - indent) << child.label << std::right
+       << std::setw(8) << stats.count << std::fixed << std::setprecision(3)
+       << std::setw(12) << totalMs << std::setw(11)
+       << totalMs / stats.count << std::setw(11) << toMs(stats.minNs)
+       << std::setw(11) << percentileMs(stats.samples, 0.5) << std::setw(11)
+       << percentileMs(stats.samples, 0.95) << std::setw(11)
+       << toMs(stats.maxNs) << std::setprecision(1) << std::setw(7)
+       << (wallMs > 0 ? totalMs / wallMs * 100 : 0) << "%\n";
+
+    printScopes(os, child, indent + 2, labelWidth, wallMs);
+  }
+}
+
+void Timer::printData(std::ostream &os) {
+  const double wallMs = toMs(nowNs() - globalStartNs());
+  MergedScope root = mergeThreads();
+
+  const size_t labelWidth = std::max<size_t>(5, maxLabelWidth(root, 0)) + 2;
+  const std::string border(labelWidth + 8 + 12 + 11 * 5 + 8, '-');
+
+  os << border << '\n'
+     << std::left << std::setw(labelWidth) << "scope" << std::right
+     << std::setw(8) << "calls" << std::setw(12) << "total ms" << std::setw(11)
+     << "mean" << std::setw(11) << "min" << std::setw(11) << "p50"
+     << std::setw(11) << "p95" << std::setw(11) << "max" << std::setw(8)
+     << "wall" << '\n'
+     << border << '\n';
+
+  printScopes(os, root, 0, labelWidth, wallMs);
+
+  os << border << '\n' << std::fixed << std::setprecision(3);
+  os << "wall time: " << wallMs << " ms\n";
+
+  // top-level scopes only, nested ones are already part of their parent
+  auto saved = std::find_if(
+      root.children.begin(), root.children.end(),
+      [](const MergedScope &scope) { return scope.label == "Saved photo"; });
+  if (saved != root.children.end()) {
+    os << "W/o png save: " << wallMs - toMs(saved->stats.totalNs) << " ms\n";
+  }
+
+  os << border << std::endl;
+}
+
+void writeJsonString(std::ostream &os, const char *text) {
+  os << '"';
+  for (const char *c = text; *c; ++c) {
+    if (*c == '"' || *c == '\\')
+      os << '\\';
+    os << *c;
+  }
+  os << '"';
+}
+
+void writeTrack(std::ostream &os, bool &first, int64_t originNs, int threadId,
+                const char *name, const std::vector<TraceEvent> &events) {
+  // threads that never timed anything would only add empty tracks
+  if (events.empty())
+    return;
+
+  os << (first ? "\n" : ",\n")
+     << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+     << threadId << ",\"args\":{\"name\":";
+  writeJsonString(os, name);
+  os << "}}";
+  first = false;
+
+  for (const TraceEvent &event : events) {
+    os << (first ? "\n" : ",\n") << "{\"name\":";
+    writeJsonString(os, event.label);
+    os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId
+       << ",\"ts\":" << std::fixed << std::setprecision(3)
+       << (event.startNs - originNs) / 1e3
+       << ",\"dur\":" << event.durationNs / 1e3 << '}';
+    first = false;
+  }
+}
+
+void Timer::writeChromeTrace(std::ostream &os) {
+  const int64_t originNs = globalStartNs();
+  ProfileRegistry &registry = profileRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  bool first = true;
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  for (const ExitedTrack &track : registry.exitedTracks) {
+    writeTrack(os, first, originNs, track.threadId, track.name, track.events);
+  }
+  for (const auto &profile : registry.threads) {
+    std::lock_guard<std::mutex> profileLock(profile->mutex);
+    writeTrack(os, first, originNs, profile->threadId, profile->name,
+               profile->events);
+  }
+
+  os << "\n]}\n";
+}
@@ -1,30 +1,32 @@
+#include "../include/atlasPic.h"
 #include "../include/Bitmap.h"
 #include "../include/picture.h"
 #include "../include/util.h"
 
-void createAtlasPic(const std::vector<Bitmap> &validTextures) {
+void createAtlasPic(const std::vector<Bitmap> &validTextures,
+                    const int blockSize, const std::string &outPath) {
   const size_t numValidTiles = validTextures.size();
   const int gridSize =
       std::ceil(std::sqrt(numValidTiles)); // Ensure a square grid
 
-  const int atlasSize = gridSize * BLOCK_SIZE;
+  const int atlasSize = gridSize * blockSize;
   Bitmap bitmapOut(atlasSize, atlasSize);
 
 
   for (size_t i = 0; i < numValidTiles; i++) {
     Bitmap bitmap(validTextures[i]);
 
-    int xOffset = (i % gridSize) * BLOCK_SIZE; // Column position
-    int yOffset = (i / gridSize) * BLOCK_SIZE; // Row position
+    int xOffset = (i % gridSize) * blockSize; // Column position
+    int yOffset = (i / gridSize) * blockSize; // Row position
 
-    for (size_t j = 0; j < BLOCK_SIZE; j++) {
-      for (size_t k = 0; k < BLOCK_SIZE; k++) {
+    for (int j = 0; j < blockSize; j++) {
+      for (int k = 0; k < blockSize; k++) {
 
         bitmapOut.set(xOffset + k, yOffset + j, bitmap.get(k, j));
       }
     }
   }
 
-  Picture atlasPic(bitmapOut, BLOCK_SIZE);
-  atlasPic.save("./outputPics/atlasPic.png");
+  Picture atlasPic(bitmapOut, atlasZoom(blockSize));
+  atlasPic.save(outPath);
 }
@@ -0,0 +1,201 @@
+#include "../include/batch.h"
+#include "../include/Timer.h"
+#include "../include/picture.h"
+#include "../include/texturePic.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// images waiting between two stages. Each one holds a decoded photo or a
+// lookup table, so this is what bounds the batch's memory use
+constexpr size_t QUEUE_DEPTH = 2;
+
+template<typename T> class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    void push(T item)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [&] { return m_items.size() < m_capacity; });
+        m_items.push_back(std::move(item));
+        m_notEmpty.notify_one();
+    }
+
+    // no more items will be pushed
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+    }
+
+    // empty once the queue is closed and drained
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [&] { return !m_items.empty() || m_closed; });
+        if (m_items.empty())
+            return std::nullopt;
+
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        m_notFull.notify_one();
+        return item;
+    }
+
+private:
+    size_t m_capacity;
+    std::deque<T> m_items;
+    bool m_closed = false;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+};
+
+// an image on its way through the pipeline. error is set once a stage fails,
+// later stages pass it along untouched
+struct DecodedJob {
+    std::string path;
+    std::optional<Picture> picture;
+    std::string error;
+};
+
+struct MatchedJob {
+    std::string path;
+    std::vector<std::vector<int>> lookupTable;
+    std::string error;
+};
+
+// ".png", ".PNG" and every mix of cases
+bool hasPngExtension(std::filesystem::path const& path)
+{
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c) { return std::tolower(c); });
+    return extension == ".png";
+}
+
+std::vector<std::string> collectBatchInputs(std::vector<std::string> const& args)
+{
+    std::vector<std::string> inputs;
+
+    for (auto const& arg : args) {
+        if (!std::filesystem::is_directory(arg)) {
+            inputs.push_back(arg);
+            continue;
+        }
+
+        std::vector<std::string> dirInputs;
+        for (auto const& entry : std::filesystem::directory_iterator(arg)) {
+            if (entry.is_regular_file() && hasPngExtension(entry.path())) {
+                dirInputs.push_back(entry.path().string());
+            }
+        }
+
+        std::sort(dirInputs.begin(), dirInputs.end());
+        inputs.insert(inputs.end(), dirInputs.begin(), dirInputs.end());
+    }
+
+    // outputs are named by stem, so two inputs sharing one would overwrite
+    std::map<std::string, std::string> pathByStem;
+    for (auto const& input : inputs) {
+        std::string const stem = std::filesystem::path(input).stem().string();
+        auto const [existing, inserted] = pathByStem.emplace(stem, input);
+        if (!inserted)
+            throw std::invalid_argument(
+                "inputs " + existing->second + " and " + input + " would both write " + stem
+                + "_textured, rename one of them");
+    }
+
+    return inputs;
+}
+
+std::string batchOutputPath(
+    std::string const& inputPath, std::string const& outDir, OutputFormat format)
+{
+    std::string const stem = std::filesystem::path(inputPath).stem().string();
+    return (std::filesystem::path(outDir) / (stem + "_textured" + fileExtension(format))).string();
+}
+
+int runBatch(std::vector<std::string> const& inputs, std::string const& outDir,
+    OutputFormat format, std::vector<Bitmap> const& validTextures,
+    std::vector<clrspc::Lab> const& textureAvgColors, MosaicConfig const& config)
+{
+    std::filesystem::create_directories(outDir);
+
+    BoundedQueue<DecodedJob> decoded(QUEUE_DEPTH);
+    BoundedQueue<MatchedJob> matched(QUEUE_DEPTH);
+
+    std::thread decoder([&] {
+        Timer::nameThread("decoder");
+        for (auto const& path : inputs) {
+            DecodedJob job { path, std::nullopt, "" };
+            try {
+                job.picture.emplace(path);
+            } catch (std::exception const& e) {
+                job.error = e.what();
+            }
+            decoded.push(std::move(job));
+        }
+        decoded.close();
+    });
+
+    std::thread matcher([&] {
+        Timer::nameThread("matcher");
+        while (auto job = decoded.pop()) {
+            MatchedJob result { job->path, {}, job->error };
+            if (result.error.empty()) {
+                try {
+                    result.lookupTable
+                        = buildTextureLookupTable(*job->picture, textureAvgColors, config);
+                    if (result.lookupTable.empty() || result.lookupTable[0].empty())
+                        result.error = "image is too small for a single block";
+                } catch (std::exception const& e) {
+                    result.error = e.what();
+                }
+            }
+            matched.push(std::move(result));
+        }
+        matched.close();
+    });
+
+    // the encoder runs on this thread
+    int failures = 0;
+    while (auto job = matched.pop()) {
+        if (job->error.empty()) {
+            try {
+                createTexturedPic(job->lookupTable, validTextures,
+                    batchOutputPath(job->path, outDir, format), format, config.blockSize);
+            } catch (std::exception const& e) {
+                job->error = e.what();
+            }
+        }
+
+        if (!job->error.empty()) {
+            std::cerr << job->path << ": " << job->error << '\n';
+            ++failures;
+        }
+    }
+
+    decoder.join();
+    matcher.join();
+
+    return failures;
+}
@@ -0,0 +1,151 @@
+#include "../include/colorHistogram.h"
+#include "../include/Timer.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// one chunk per core, like process2dInParallel, so each chunk's table is
+// only ever touched by one thread
+int numRowChunks(int height)
+{
+    return std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), height));
+}
+
+DistinctColors findDistinctColors(Bitmap const& bitmap)
+{
+    Timer timer("findDistinctColors");
+    constexpr size_t NUM_WORDS = DistinctColors::NUM_WORDS;
+    int const numChunks = numRowChunks(bitmap.m_height);
+
+    DistinctColors distinct;
+    distinct.present = std::vector<std::atomic<uint64_t>>(NUM_WORDS);
+    distinct.rank.resize(NUM_WORDS);
+
+    // a word is only written the first time one of its colors shows up, so
+    // the cores mostly share it read-only
+    process2dInParallel(numChunks, 1, [&](int, int chunk) {
+        int const startRow = static_cast<long>(bitmap.m_height) * chunk / numChunks;
+        int const endRow = static_cast<long>(bitmap.m_height) * (chunk + 1) / numChunks;
+
+        for (int y = startRow; y < endRow; ++y) {
+            uchar const* px = &bitmap.m_bits[Bitmap::CHANNELS * y * bitmap.m_width];
+            for (int x = 0; x < bitmap.m_width; ++x, px += Bitmap::CHANNELS) {
+                uint32_t const rgb = packRgb(px);
+                uint64_t const bit = uint64_t(1) << (rgb & 63);
+                std::atomic<uint64_t>& word = distinct.present[rgb >> 6];
+                if (!(word.load(std::memory_order_relaxed) & bit))
+                    word.fetch_or(bit, std::memory_order_relaxed);
+            }
+        }
+    }, "distinct colors worker");
+
+    uint32_t numColors = 0;
+    for (size_t w = 0; w < NUM_WORDS; ++w) {
+        distinct.rank[w] = numColors;
+        uint64_t const word = distinct.present[w].load(std::memory_order_relaxed);
+        if (!word)
+            continue;
+
+        numColors += popcount64(word);
+
+        for (uint64_t bits = word; bits; bits &= bits - 1) {
+            distinct.colors.push_back(static_cast<uint32_t>(64 * w + countTrailingZeros64(bits)));
+        }
+    }
+
+    return distinct;
+}
+
+std::vector<ColorBin> buildColorHistogram(Bitmap const& bitmap, int bitsPerChannel)
+{
+    if (bitsPerChannel < 1 || bitsPerChannel > 6)
+        throw std::invalid_argument("a histogram needs 1 to 6 bits per channel, "
+                                    "buildExactColorHistogram has one bin per color");
+
+    Timer timer("buildColorHistogram");
+    int const shift = 8 - bitsPerChannel;
+    size_t const numBins = size_t(1) << (3 * bitsPerChannel);
+    int const numChunks = numRowChunks(bitmap.m_height);
+
+    // channel sums and the pixel count of every bin, per chunk of rows
+    std::vector<std::vector<std::array<uint64_t, 4>>> chunkSums(numChunks);
+
+    process2dInParallel(numChunks, 1, [&](int, int chunk) {
+        int const startRow = static_cast<long>(bitmap.m_height) * chunk / numChunks;
+        int const endRow = static_cast<long>(bitmap.m_height) * (chunk + 1) / numChunks;
+        std::vector<std::array<uint64_t, 4>>& sums = chunkSums[chunk];
+        sums.resize(numBins);
+
+        for (int y = startRow; y < endRow; ++y) {
+            uchar const* px = &bitmap.m_bits[Bitmap::CHANNELS * y * bitmap.m_width];
+            for (int x = 0; x < bitmap.m_width; ++x, px += Bitmap::CHANNELS) {
+                size_t const bin = (size_t(px[0] >> shift) << (2 * bitsPerChannel))
+                    | (size_t(px[1] >> shift) << bitsPerChannel) | size_t(px[2] >> shift);
+
+                sums[bin][0] += px[0];
+                sums[bin][1] += px[1];
+                sums[bin][2] += px[2];
+                ++sums[bin][3];
+            }
+        }
+    }, "histogram worker");
+
+    std::vector<ColorBin> bins;
+    for (size_t bin = 0; bin < numBins; ++bin) {
+        std::array<uint64_t, 4> total {};
+        for (auto const& sums : chunkSums) {
+            for (int v = 0; v < 4; ++v) {
+                total[v] += sums[bin][v];
+            }
+        }
+
+        auto const [r, g, b, count] = total;
+        if (count == 0)
+            continue;
+
+        clrspc::Rgb const mean(float(r) / count, float(g) / count, float(b) / count);
+        bins.push_back({ mean.to_lab(), static_cast<uint32_t>(count) });
+    }
+
+    return bins;
+}
+
+std::vector<ColorBin> buildExactColorHistogram(Bitmap const& bitmap)
+{
+    DistinctColors const distinct = findDistinctColors(bitmap);
+    Timer timer("buildExactColorHistogram");
+    int const numChunks = numRowChunks(bitmap.m_height);
+    std::vector<std::atomic<uint32_t>> counts(distinct.colors.size());
+
+    process2dInParallel(numChunks, 1, [&](int, int chunk) {
+        int const startRow = static_cast<long>(bitmap.m_height) * chunk / numChunks;
+        int const endRow = static_cast<long>(bitmap.m_height) * (chunk + 1) / numChunks;
+
+        for (int y = startRow; y < endRow; ++y) {
+            uchar const* px = &bitmap.m_bits[Bitmap::CHANNELS * y * bitmap.m_width];
+            int x = 0;
+            while (x < bitmap.m_width) {
+                // a run of one color is added at once, flat areas would
+                // otherwise have every core fight over the same counter
+                uint32_t const rgb = packRgb(px);
+                uint32_t run = 0;
+                for (; x < bitmap.m_width && packRgb(px) == rgb; ++x, px += Bitmap::CHANNELS) {
+                    ++run;
+                }
+                counts[distinct.indexOf(rgb)].fetch_add(run, std::memory_order_relaxed);
+            }
+        }
+    }, "histogram worker");
+
+    std::vector<ColorBin> bins(distinct.colors.size(), { clrspc::Lab(0, 0, 0), 0 });
+    process2dInParallel(bins.size(), 1, [&](int, int k) {
+        bins[k] = { unpackRgb(distinct.colors[k]).to_lab(), counts[k].load(std::memory_order_relaxed) };
+    }, "histogram worker");
+
+    return bins;
+}
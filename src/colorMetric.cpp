@@ -0,0 +1,319 @@
+#include "../include/colorMetric.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// how much more a lightness difference counts in WeightedOkLab
+constexpr float LIGHTNESS_WEIGHT = 2.f;
+
+constexpr double PI = 3.14159265358979323846;
+
+ColorMetric parseColorMetric(std::string const& name)
+{
+    if (name == "oklab")
+        return ColorMetric::OkLab;
+    if (name == "weighted_oklab")
+        return ColorMetric::WeightedOkLab;
+    if (name == "ciede2000")
+        return ColorMetric::Ciede2000;
+    if (name == "cam16_ucs")
+        return ColorMetric::Cam16Ucs;
+
+    throw std::invalid_argument("unknown color metric: " + name);
+}
+
+// CIE XYZ under D65 with Y of white at 1, through the linear sRGB that
+// inverting OkLab gives. Out of gamut channels go through unclamped
+std::array<float, 3> toXyz(clrspc::Lab const& color)
+{
+    auto const [L, a, b] = color.get_values();
+
+    float const l_ = L + 0.3963377774f * a + 0.2158037573f * b;
+    float const m_ = L - 0.1055613458f * a - 0.0638541728f * b;
+    float const s_ = L - 0.0894841775f * a - 1.2914855480f * b;
+
+    float const l = l_ * l_ * l_;
+    float const m = m_ * m_ * m_;
+    float const s = s_ * s_ * s_;
+
+    std::array<float, 3> const rgb = {
+        +4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s,
+        -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s,
+        -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s,
+    };
+
+    std::array<std::array<float, 3>, 3> const rgbToXyz = { {
+        { 0.4124564f, 0.3575761f, 0.1804375f },
+        { 0.2126729f, 0.7151522f, 0.0721750f },
+        { 0.0193339f, 0.1191920f, 0.9503041f },
+    } };
+    return multiplyMatrix(rgbToXyz, rgb);
+}
+
+std::array<float, 3> toCieLab(clrspc::Lab const& color)
+{
+    std::array<float, 3> const white = { 0.95047f, 1.f, 1.08883f };
+    std::array<float, 3> xyz = toXyz(color);
+
+    constexpr float delta = 6.f / 29.f;
+    for (int i = 0; i < 3; ++i) {
+        float const t = xyz[i] / white[i];
+        xyz[i] = t > delta * delta * delta ? std::cbrt(t) : t / (3 * delta * delta) + 4.f / 29.f;
+    }
+
+    return { 116 * xyz[1] - 16, 500 * (xyz[0] - xyz[1]), 200 * (xyz[1] - xyz[2]) };
+}
+
+// everything of CAM16 that only depends on the viewing conditions
+struct Cam16Conditions {
+    std::array<float, 3> degreeOfAdaptation;
+    float luminanceAdaptation;
+    float backgroundRatio;
+    float z;
+    float inductionFactor;
+    float achromaticWhite;
+    // average surround
+    float surroundC = 0.69f;
+    float surroundN = 1.f;
+};
+
+std::array<std::array<float, 3>, 3> const CAM16_M16 = { {
+    { 0.401288f, 0.650173f, -0.051461f },
+    { -0.250268f, 1.204414f, 0.045854f },
+    { -0.002079f, 0.048952f, 0.953127f },
+} };
+
+// post-adaptation compression of one cone response
+float cam16Compress(float c, float luminanceAdaptation)
+{
+    float const x = std::pow(luminanceAdaptation * std::abs(c) / 100, 0.42f);
+    return std::copysign(400 * x / (x + 27.13f), c) + 0.1f;
+}
+
+Cam16Conditions const& cam16Conditions()
+{
+    static Cam16Conditions const conditions = [] {
+        std::array<float, 3> const whiteXyz = { 95.047f, 100.f, 108.883f };
+        float const adaptingLuminance = 64 / PI * 0.2;
+        float const backgroundY = 20;
+        float const surroundF = 1;
+
+        Cam16Conditions vc;
+        std::array<float, 3> const whiteRgb = multiplyMatrix(CAM16_M16, whiteXyz);
+        float const d = std::clamp(
+            surroundF * (1 - 1 / 3.6f * std::exp((-adaptingLuminance - 42) / 92)), 0.f, 1.f);
+        for (int i = 0; i < 3; ++i) {
+            vc.degreeOfAdaptation[i] = d * whiteXyz[1] / whiteRgb[i] + 1 - d;
+        }
+
+        float const k = 1 / (5 * adaptingLuminance + 1);
+        float const k4 = k * k * k * k;
+        vc.luminanceAdaptation = 0.2f * k4 * 5 * adaptingLuminance
+            + 0.1f * (1 - k4) * (1 - k4) * std::cbrt(5 * adaptingLuminance);
+        vc.backgroundRatio = backgroundY / whiteXyz[1];
+        vc.z = 1.48f + std::sqrt(vc.backgroundRatio);
+        vc.inductionFactor = 0.725f * std::pow(vc.backgroundRatio, -0.2f);
+
+        std::array<float, 3> adapted;
+        for (int i = 0; i < 3; ++i) {
+            adapted[i] = cam16Compress(
+                vc.degreeOfAdaptation[i] * whiteRgb[i], vc.luminanceAdaptation);
+        }
+        vc.achromaticWhite
+            = (2 * adapted[0] + adapted[1] + adapted[2] / 20 - 0.305f) * vc.inductionFactor;
+        return vc;
+    }();
+
+    return conditions;
+}
+
+std::array<float, 3> toCam16Ucs(clrspc::Lab const& color)
+{
+    Cam16Conditions const& vc = cam16Conditions();
+
+    std::array<float, 3> xyz = toXyz(color);
+    for (float& c : xyz) {
+        c *= 100;
+    }
+
+    std::array<float, 3> const rgb = multiplyMatrix(CAM16_M16, xyz);
+    std::array<float, 3> adapted;
+    for (int i = 0; i < 3; ++i) {
+        adapted[i] = cam16Compress(vc.degreeOfAdaptation[i] * rgb[i], vc.luminanceAdaptation);
+    }
+    auto const [ra, ga, ba] = adapted;
+
+    float const a = ra - 12 * ga / 11 + ba / 11;
+    float const b = (ra + ga - 2 * ba) / 9;
+    float const hue = std::atan2(b, a);
+
+    float const achromatic = (2 * ra + ga + ba / 20 - 0.305f) * vc.inductionFactor;
+    float const lightness
+        = 100 * std::pow(std::max(achromatic, 0.f) / vc.achromaticWhite, vc.surroundC * vc.z);
+
+    float const eccentricity = 0.25f * (std::cos(hue + 2) + 3.8f);
+    float const t = 50000.f / 13 * vc.surroundN * vc.inductionFactor * eccentricity
+        * std::sqrt(a * a + b * b) / (ra + ga + 21 * ba / 20);
+    float const chroma = std::pow(std::max(t, 0.f), 0.9f) * std::sqrt(lightness / 100)
+        * std::pow(1.64f - std::pow(0.29f, vc.backgroundRatio), 0.73f);
+    float const colorfulness = chroma * std::pow(vc.luminanceAdaptation, 0.25f);
+
+    float const uniformM = std::log1p(0.0228f * colorfulness) / 0.0228f;
+    return { 1.7f * lightness / (1 + 0.007f * lightness), uniformM * std::cos(hue),
+        uniformM * std::sin(hue) };
+}
+
+// after Sharma, Wu and Dalal, "The CIEDE2000 color-difference formula:
+// implementation notes, supplementary test data, and mathematical observations"
+float ciede2000(std::array<float, 3> const& lab1, std::array<float, 3> const& lab2)
+{
+    auto const [l1, a1, b1] = lab1;
+    auto const [l2, a2, b2] = lab2;
+    double const toRad = PI / 180;
+    double const pow25To7 = 6103515625.0;
+
+    double const meanC = (std::hypot(a1, b1) + std::hypot(a2, b2)) / 2;
+    double const meanC7 = std::pow(meanC, 7);
+    double const g = 0.5 * (1 - std::sqrt(meanC7 / (meanC7 + pow25To7)));
+
+    double const a1p = (1 + g) * a1;
+    double const a2p = (1 + g) * a2;
+    double const c1p = std::hypot(a1p, double(b1));
+    double const c2p = std::hypot(a2p, double(b2));
+
+    auto hueDegrees = [](double b, double a) {
+        if (a == 0 && b == 0)
+            return 0.0;
+        double const h = std::atan2(b, a) / (PI / 180);
+        return h < 0 ? h + 360 : h;
+    };
+    double const h1p = hueDegrees(b1, a1p);
+    double const h2p = hueDegrees(b2, a2p);
+
+    double const deltaL = l2 - l1;
+    double const deltaC = c2p - c1p;
+    double deltah = 0;
+    if (c1p * c2p != 0) {
+        deltah = h2p - h1p;
+        if (deltah > 180)
+            deltah -= 360;
+        else if (deltah < -180)
+            deltah += 360;
+    }
+    double const deltaH = 2 * std::sqrt(c1p * c2p) * std::sin(deltah / 2 * toRad);
+
+    double const meanL = (l1 + l2) / 2.0;
+    double const meanCp = (c1p + c2p) / 2;
+    double meanH = h1p + h2p;
+    if (c1p * c2p != 0) {
+        if (std::abs(h1p - h2p) <= 180)
+            meanH /= 2;
+        else
+            meanH = meanH < 360 ? (meanH + 360) / 2 : (meanH - 360) / 2;
+    }
+
+    double const t = 1 - 0.17 * std::cos((meanH - 30) * toRad)
+        + 0.24 * std::cos(2 * meanH * toRad) + 0.32 * std::cos((3 * meanH + 6) * toRad)
+        - 0.20 * std::cos((4 * meanH - 63) * toRad);
+    double const deltaTheta = 30 * std::exp(-std::pow((meanH - 275) / 25, 2));
+    double const meanCp7 = std::pow(meanCp, 7);
+    double const rc = 2 * std::sqrt(meanCp7 / (meanCp7 + pow25To7));
+    double const sl
+        = 1 + 0.015 * (meanL - 50) * (meanL - 50) / std::sqrt(20 + (meanL - 50) * (meanL - 50));
+    double const sc = 1 + 0.045 * meanCp;
+    double const sh = 1 + 0.015 * meanCp * t;
+    double const rt = -std::sin(2 * deltaTheta * toRad) * rc;
+
+    double const l = deltaL / sl;
+    double const c = deltaC / sc;
+    double const h = deltaH / sh;
+    return std::sqrt(l * l + c * c + h * h + rt * c * h);
+}
+
+ColorMatcher::ColorMatcher(
+    std::vector<clrspc::Lab> const& palette, ColorMetric metric, int candidates)
+    : m_palette(palette)
+    , m_metric(metric)
+    , m_candidates(candidates)
+{
+    if (m_metric == ColorMetric::OkLab)
+        return;
+
+    m_points.reserve(palette.size());
+    for (clrspc::Lab const& color : palette) {
+        m_points.push_back(toMetricSpace(color));
+    }
+}
+
+std::array<float, 3> ColorMatcher::toMetricSpace(clrspc::Lab const& color) const
+{
+    switch (m_metric) {
+    case ColorMetric::WeightedOkLab:
+        return { LIGHTNESS_WEIGHT * color.l(), color.a(), color.b() };
+    case ColorMetric::Ciede2000:
+        return toCieLab(color);
+    case ColorMetric::Cam16Ucs:
+        return toCam16Ucs(color);
+    case ColorMetric::OkLab:
+        break;
+    }
+    return color.get_values();
+}
+
+size_t ColorMatcher::closest(clrspc::Lab const& color) const
+{
+    if (m_metric == ColorMetric::OkLab)
+        return findClosestColorIdx(color, m_palette);
+
+    std::array<float, 3> const target = toMetricSpace(color);
+    size_t closestIdx = 0;
+    float minDist = std::numeric_limits<float>::max();
+
+    if (m_metric != ColorMetric::Ciede2000) {
+        for (size_t i = 0; i < m_points.size(); ++i) {
+            float const dl = target[0] - m_points[i][0];
+            float const da = target[1] - m_points[i][1];
+            float const db = target[2] - m_points[i][2];
+            float const dist = dl * dl + da * da + db * db;
+            if (dist < minDist) {
+                minDist = dist;
+                closestIdx = i;
+            }
+        }
+        return closestIdx;
+    }
+
+    size_t const numCandidates = m_candidates > 0
+        ? std::min(static_cast<size_t>(m_candidates), m_palette.size())
+        : m_palette.size();
+
+    // the numCandidates entries nearest in OkLab, nearest first. Ties keep
+    // the lower index, like findClosestColorIdx
+    std::vector<std::pair<float, size_t>> shortlist;
+    shortlist.reserve(numCandidates + 1);
+    for (size_t i = 0; i < m_palette.size(); ++i) {
+        float const dist = distSquared(color, m_palette[i]);
+        if (shortlist.size() == numCandidates && !(dist < shortlist.back().first))
+            continue;
+
+        auto const pos = std::upper_bound(shortlist.begin(), shortlist.end(), dist,
+            [](float d, std::pair<float, size_t> const& entry) { return d < entry.first; });
+        shortlist.insert(pos, { dist, i });
+        if (shortlist.size() > numCandidates)
+            shortlist.pop_back();
+    }
+
+    for (auto const& [okLabDist, i] : shortlist) {
+        float const dist = ciede2000(target, m_points[i]);
+        if (dist < minDist) {
+            minDist = dist;
+            closestIdx = i;
+        }
+    }
+    return closestIdx;
+}
@@ -0,0 +1,358 @@
+#include "../include/dither.h"
+#include "../include/Timer.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// error moves from (x, y) to (x + dx, y + dy)
+struct DiffusionTap {
+    int dx;
+    int dy;
+    float weight;
+};
+
+// the most rows below the current one any kernel reaches
+constexpr int MAX_REACH = 2;
+
+std::vector<DiffusionTap> diffusionTaps(DitherMethod method)
+{
+    switch (method) {
+    case DitherMethod::FloydSteinberg:
+        return { { 1, 0, 7 / 16.f }, { -1, 1, 3 / 16.f }, { 0, 1, 5 / 16.f },
+            { 1, 1, 1 / 16.f } };
+    case DitherMethod::SierraLite:
+        return { { 1, 0, 2 / 4.f }, { -1, 1, 1 / 4.f }, { 0, 1, 1 / 4.f } };
+    case DitherMethod::Jarvis:
+        return { { 1, 0, 7 / 48.f }, { 2, 0, 5 / 48.f }, { -2, 1, 3 / 48.f },
+            { -1, 1, 5 / 48.f }, { 0, 1, 7 / 48.f }, { 1, 1, 5 / 48.f }, { 2, 1, 3 / 48.f },
+            { -2, 2, 1 / 48.f }, { -1, 2, 3 / 48.f }, { 0, 2, 5 / 48.f }, { 1, 2, 3 / 48.f },
+            { 2, 2, 1 / 48.f } };
+    case DitherMethod::None:
+    case DitherMethod::Bayer:
+    case DitherMethod::BlueNoise:
+        break;
+    }
+    return {};
+}
+
+DitherMethod parseDitherMethod(std::string const& name)
+{
+    if (name == "none")
+        return DitherMethod::None;
+    if (name == "floyd_steinberg")
+        return DitherMethod::FloydSteinberg;
+    if (name == "sierra_lite")
+        return DitherMethod::SierraLite;
+    if (name == "jarvis")
+        return DitherMethod::Jarvis;
+    if (name == "bayer")
+        return DitherMethod::Bayer;
+    if (name == "blue_noise")
+        return DitherMethod::BlueNoise;
+
+    throw std::invalid_argument("unknown dither method: " + name);
+}
+
+constexpr int BAYER_SIZE = 8;
+constexpr int BLUE_NOISE_SIZE = 64;
+
+// position of (x, y) in the order an 8x8 Bayer matrix turns its pixels on,
+// 0 to 63. Each bit of the coordinates picks a quadrant of the recursive
+// 2x2 pattern { 0, 2 }, { 3, 1 }; the lowest bits weigh the most
+constexpr int bayerRank(int x, int y)
+{
+    int rank = 0;
+    for (int bit = 0; bit < 3; ++bit) {
+        int const xBit = (x >> bit) & 1;
+        int const yBit = (y >> bit) & 1;
+        rank |= ((xBit ^ yBit) << 1 | yBit) << (2 * (2 - bit));
+    }
+    return rank;
+}
+
+// ranks of a BLUE_NOISE_SIZE x BLUE_NOISE_SIZE tile by void and cluster
+// (Ulichney 1993): starting from a few random points, every next point goes
+// into the largest void, the pixel with the least Gaussian-weighted energy
+// from the points already placed, after the initial points were spread out
+// and ranked by removing the tightest cluster first. The tile wraps around, so
+// it tiles without seams. Built once, on first use
+std::vector<int> const& blueNoiseRanks()
+{
+    static std::vector<int> const ranks = [] {
+        int constexpr N = BLUE_NOISE_SIZE;
+        int constexpr RADIUS = 6;
+        float constexpr SIGMA = 1.5f;
+        int constexpr INITIAL_POINTS = N * N / 10;
+
+        std::vector<float> kernel((2 * RADIUS + 1) * (2 * RADIUS + 1));
+        for (int dy = -RADIUS; dy <= RADIUS; ++dy) {
+            for (int dx = -RADIUS; dx <= RADIUS; ++dx) {
+                kernel[(dy + RADIUS) * (2 * RADIUS + 1) + dx + RADIUS]
+                    = std::exp(-(dx * dx + dy * dy) / (2 * SIGMA * SIGMA));
+            }
+        }
+
+        std::vector<char> isSet(N * N, false);
+        std::vector<float> energy(N * N, 0);
+        auto toggle = [&](int p, bool set) {
+            isSet[p] = set;
+            int const px = p % N;
+            int const py = p / N;
+            for (int dy = -RADIUS; dy <= RADIUS; ++dy) {
+                for (int dx = -RADIUS; dx <= RADIUS; ++dx) {
+                    int const q = ((py + dy + N) % N) * N + (px + dx + N) % N;
+                    float const weight = kernel[(dy + RADIUS) * (2 * RADIUS + 1) + dx + RADIUS];
+                    energy[q] += set ? weight : -weight;
+                }
+            }
+        };
+        // the set point with the most energy, or the free one with the least
+        auto extreme = [&](bool set) {
+            int best = -1;
+            for (int p = 0; p < N * N; ++p) {
+                if (isSet[p] == set
+                    && (best < 0 || (set ? energy[p] > energy[best] : energy[p] < energy[best]))) {
+                    best = p;
+                }
+            }
+            return best;
+        };
+
+        unsigned seed = 1;
+        for (int placed = 0; placed < INITIAL_POINTS;) {
+            seed = seed * 1664525u + 1013904223u;
+            int const p = (seed >> 8) % (N * N);
+            if (!isSet[p]) {
+                toggle(p, true);
+                ++placed;
+            }
+        }
+
+        // move points from the tightest cluster into the largest void until
+        // that no longer changes anything
+        for (int step = 0; step < N * N; ++step) {
+            int const cluster = extreme(true);
+            toggle(cluster, false);
+            int const gap = extreme(false);
+            toggle(gap, true);
+            if (gap == cluster)
+                break;
+        }
+
+        std::vector<int> ranks(N * N);
+        std::vector<char> const initial = isSet;
+        std::vector<float> const initialEnergy = energy;
+
+        for (int rank = INITIAL_POINTS - 1; rank >= 0; --rank) {
+            int const cluster = extreme(true);
+            toggle(cluster, false);
+            ranks[cluster] = rank;
+        }
+
+        isSet = initial;
+        energy = initialEnergy;
+        for (int rank = INITIAL_POINTS; rank < N * N; ++rank) {
+            int const gap = extreme(false);
+            toggle(gap, true);
+            ranks[gap] = rank;
+        }
+
+        return ranks;
+    }();
+
+    return ranks;
+}
+
+// the threshold of (x, y) in [0, 1). Channel c reads the matrix shifted by a
+// third of its size for every channel, so the three offsets are uncorrelated
+float orderedThreshold(DitherMethod method, int x, int y, int c)
+{
+    if (method == DitherMethod::Bayer) {
+        int const shift = c * BAYER_SIZE / 3;
+        return (bayerRank((x + shift) % BAYER_SIZE, (y + 2 * shift) % BAYER_SIZE) + 0.5f)
+            / (BAYER_SIZE * BAYER_SIZE);
+    }
+
+    int const shift = c * BLUE_NOISE_SIZE / 3;
+    int const tx = (x + shift) % BLUE_NOISE_SIZE;
+    int const ty = (y + 2 * shift) % BLUE_NOISE_SIZE;
+    return (blueNoiseRanks()[ty * BLUE_NOISE_SIZE + tx] + 0.5f)
+        / (BLUE_NOISE_SIZE * BLUE_NOISE_SIZE);
+}
+
+// mean distance from every palette color to its nearest neighbor, the step an
+// ordered dither has to bridge
+float typicalSpacing(std::vector<clrspc::Lab> const& quantColors)
+{
+    if (quantColors.size() < 2)
+        return 0;
+
+    double sum = 0;
+    for (size_t i = 0; i < quantColors.size(); ++i) {
+        float nearest = std::numeric_limits<float>::max();
+        for (size_t j = 0; j < quantColors.size(); ++j) {
+            if (i != j) {
+                nearest = std::min(nearest, distSquared(quantColors[i], quantColors[j]));
+            }
+        }
+        sum += std::sqrt(nearest);
+    }
+
+    return sum / quantColors.size();
+}
+
+std::vector<std::vector<int>> buildOrderedLookupTable(Bitmap const& bitmap,
+    std::vector<clrspc::Lab> const& quantColors, DitherMethod method, ColorMetric metric)
+{
+    Timer timer("buildOrderedLookupTable");
+    float const spacing = typicalSpacing(quantColors);
+    ColorMatcher const matcher(quantColors, metric);
+
+    std::vector<std::vector<int>> lookupTable(bitmap.m_height, std::vector<int>(bitmap.m_width));
+
+    process2dInParallel(bitmap.m_height, 1, [&](int, int y) {
+        for (int x = 0; x < bitmap.m_width; ++x) {
+            std::array<float, 3> target = bitmap.get(x, y).to_lab().get_values();
+            for (int c = 0; c < 3; ++c) {
+                target[c] += (orderedThreshold(method, x, y, c) - 0.5f) * spacing;
+            }
+            lookupTable[y][x] = matcher.closest(clrspc::Lab(target[0], target[1], target[2]));
+        }
+    }, "ordered dither worker");
+
+    return lookupTable;
+}
+
+// (dy, lag) for every row above that sends error down: pixel x may only be
+// matched once row y - dy has finished its first x + lag pixels
+std::vector<std::pair<int, int>> rowDependencies(std::vector<DiffusionTap> const& taps)
+{
+    std::vector<std::pair<int, int>> dependencies;
+
+    for (int dy = 1; dy <= MAX_REACH; ++dy) {
+        bool found = false;
+        int lag = 0;
+        for (DiffusionTap const& tap : taps) {
+            if (tap.dy == dy) {
+                lag = found ? std::max(lag, 1 - tap.dx) : 1 - tap.dx;
+                found = true;
+            }
+        }
+        if (found) {
+            dependencies.emplace_back(dy, lag);
+        }
+    }
+
+    return dependencies;
+}
+
+std::vector<std::vector<int>> buildDitheredLookupTable(Bitmap const& bitmap,
+    std::vector<clrspc::Lab> const& quantColors, DitherMethod method, ColorMetric metric)
+{
+    if (method == DitherMethod::None || quantColors.empty())
+        return buildLookupTable(bitmap, quantColors, metric);
+    if (method == DitherMethod::Bayer || method == DitherMethod::BlueNoise)
+        return buildOrderedLookupTable(bitmap, quantColors, method, metric);
+
+    Timer timer("buildDitheredLookupTable");
+    int const width = bitmap.m_width;
+    int const height = bitmap.m_height;
+    std::vector<DiffusionTap> const taps = diffusionTaps(method);
+    std::vector<std::pair<int, int>> const dependencies = rowDependencies(taps);
+    ColorMatcher const matcher(quantColors, metric);
+
+    // a target outside the palette's range can't be matched any better, and
+    // diffusing its error would only smear it across the image
+    std::array<float, 3> low = quantColors[0].get_values();
+    std::array<float, 3> high = low;
+    for (clrspc::Lab const& color : quantColors) {
+        auto const values = color.get_values();
+        for (int c = 0; c < 3; ++c) {
+            low[c] = std::min(low[c], values[c]);
+            high[c] = std::max(high[c], values[c]);
+        }
+    }
+
+    // incoming[dy] holds the error sent by the row dy above, so every buffer
+    // has a single writer and is summed in the same order on every run
+    std::vector<std::vector<float>> incoming(
+        MAX_REACH + 1, std::vector<float>(3 * static_cast<size_t>(width) * height, 0));
+    std::vector<std::atomic<int>> progress(height);
+    for (auto& done : progress) {
+        done.store(0, std::memory_order_relaxed);
+    }
+
+    std::vector<std::vector<int>> lookupTable(height, std::vector<int>(width));
+
+    auto ditherRow = [&](int y) {
+        for (int x = 0; x < width; ++x) {
+            for (auto const& [dy, lag] : dependencies) {
+                if (dy > y)
+                    break;
+                int const needed = std::min(width, x + lag);
+                while (progress[y - dy].load(std::memory_order_acquire) < needed) {
+                    std::this_thread::yield();
+                }
+            }
+
+            size_t const offset = 3 * (static_cast<size_t>(y) * width + x);
+            std::array<float, 3> target = bitmap.get(x, y).to_lab().get_values();
+            for (int c = 0; c < 3; ++c) {
+                for (int dy = 0; dy <= MAX_REACH; ++dy) {
+                    target[c] += incoming[dy][offset + c];
+                }
+                target[c] = std::clamp(target[c], low[c], high[c]);
+            }
+
+            int const idx = matcher.closest(clrspc::Lab(target[0], target[1], target[2]));
+            lookupTable[y][x] = idx;
+
+            auto const chosen = quantColors[idx].get_values();
+            for (DiffusionTap const& tap : taps) {
+                int const tx = x + tap.dx;
+                int const ty = y + tap.dy;
+                if (tx < 0 || tx >= width || ty >= height)
+                    continue;
+
+                float* const out = &incoming[tap.dy][3 * (static_cast<size_t>(ty) * width + tx)];
+                for (int c = 0; c < 3; ++c) {
+                    out[c] += (target[c] - chosen[c]) * tap.weight;
+                }
+            }
+
+            progress[y].store(x + 1, std::memory_order_release);
+        }
+    };
+
+    // rows are dealt out round-robin, so every thread works a few pixels behind
+    // the one handling the row above it
+    int const numThreads
+        = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), height));
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            Timer::nameThread("worker");
+            Timer workerTimer("dither worker");
+
+            for (int y = t; y < height; y += numThreads) {
+                ditherRow(y);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return lookupTable;
+}
@@ -1,11 +1,18 @@
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 
 #include "../include/Timer.h"
 #include "../include/picture.h"
 #include "../include/util.h"
 
+// fixed-point kernel weights are Q14: 1.0 == 2^14
+constexpr int FIXED_SHIFT = 14;
+constexpr uint32_t FIXED_ONE = 1u << FIXED_SHIFT;
+constexpr uint32_t FIXED_HALF = FIXED_ONE >> 1;
+
 int mirrorPixel(int x, int max) {
   if (x < 0)
     return -x; // Mirror left/top side
@@ -37,14 +44,56 @@ std::vector<double> calcGaussianKernelComponent(size_t size) {
 }
 
 
+// scales the normalized kernel so its integer weights sum to exactly 2^14.
+// every weight then fits in 16 bits and a full tap sum over 8-bit channels
+// (255 * 2^14) fits in a 32-bit accumulator, so the blur is integer-only and
+// produces bit-identical output on every machine
+std::vector<uint16_t> calcFixedKernelComponent(const std::vector<double> &kernel) {
+  std::vector<uint16_t> fixedKernel(kernel.size());
+  int sum = 0;
+
+  for (size_t i = 0; i < kernel.size(); i++) {
+    fixedKernel[i] = std::lround(kernel[i] * FIXED_ONE);
+    sum += fixedKernel[i];
+  }
+
+  // rounding error is absorbed by the center tap so the kernel stays normalized
+  fixedKernel[kernel.size() / 2] += FIXED_ONE - sum;
+
+  return fixedKernel;
+}
+
+
+// accumulates one weighted tap over a whole interleaved RGBA row. Written as a
+// flat loop over bytes so the compiler can vectorize it.
+inline void accumulateRow(uint32_t *acc, const uchar *src, const uint16_t weight,
+                          const size_t count) {
+  for (size_t n = 0; n < count; n++) {
+    acc[n] += weight * src[n];
+  }
+}
+
+
+// rounds the accumulators back to 8-bit channels and forces alpha opaque
+inline void storeRow(uchar *dst, const uint32_t *acc, const size_t count) {
+  for (size_t n = 0; n < count; n++) {
+    dst[n] = (acc[n] + FIXED_HALF) >> FIXED_SHIFT;
+  }
+  for (size_t n = 3; n < count; n += 4) {
+    dst[n] = 255;
+  }
+}
+
+
 void Picture::gaussianBlur(const size_t strength) {
   Timer timer("Gaussian Blur");
   if (strength < 1)
     return;
 
-  Picture tempPic = *this;
-  const size_t width = _width;
-  const size_t height = _height;
+  const int width = _width;
+  const int height = _height;
+  const size_t rowBytes = 4 * width;
+  std::vector<uchar> tempValues(_values.size());
 
   // kSize will be rounded down to an odd number to keep target pixel centered
   const size_t kSize = strength % 2 ? strength : strength - 1;
@@ -53,42 +102,48 @@ void Picture::gaussianBlur(const size_t strength) {
   const int kRadius = kSize / 2;
 
   // used both as an 1 x kSize kernel and a transposed kSize x 1 kernel
-  std::vector<double> gaussianKernelComponent =
-      calcGaussianKernelComponent(kSize);
-
-  //  horizontal first pass writes to temporary picture object
-  process2dInParallel(height, width, [&](int i, int j) {
-    double rWeightedAvg = 0;
-    double gWeightedAvg = 0;
-    double bWeightedAvg = 0;
-
-    for (int k = -kRadius; k <= kRadius; k++) {
-      const double weight = gaussianKernelComponent[k + kRadius];
-      const size_t pixel = mirrorPixel(i + k, width);
-
-      rWeightedAvg += weight * this->red(pixel, j);
-      gWeightedAvg += weight * this->green(pixel, j);
-      bWeightedAvg += weight * this->blue(pixel, j);
-    }
-
-    tempPic.set(i, j, rWeightedAvg, gWeightedAvg, bWeightedAvg, 255);
-  });
+  const std::vector<uint16_t> kernel =
+      calcFixedKernelComponent(calcGaussianKernelComponent(kSize));
+
+  auto edgePixel = [](int x, int max) {
+    return std::clamp(mirrorPixel(x, max), 0, max - 1);
+  };
+
+  //  horizontal first pass writes to temporary buffer. Each row is padded with
+  //  its mirrored edges so every tap reads a contiguous run of bytes
+  {
+    Timer passTimer("horizontal blur pass");
+    process2dInParallel(height, 1, [&](int, int j) {
+      std::vector<uchar> padded(4 * (width + 2 * kRadius));
+      std::vector<uint32_t> acc(rowBytes, 0);
+      const uchar *srcRow = &_values[j * rowBytes];
+
+      for (int x = -kRadius; x < width + kRadius; x++) {
+        std::memcpy(&padded[4 * (x + kRadius)],
+                    &srcRow[4 * edgePixel(x, width)], 4);
+      }
+
+      for (size_t k = 0; k < kSize; k++) {
+        accumulateRow(acc.data(), &padded[4 * k], kernel[k], rowBytes);
+      }
+
+      storeRow(&tempValues[j * rowBytes], acc.data(), rowBytes);
+    }, "horizontal blur worker");
+  }
 
   // vertical second pass writes directly to final picture object
-  process2dInParallel(height, width, [&](int i, int j) {
-    double rWeightedAvg = 0;
-    double gWeightedAvg = 0;
-    double bWeightedAvg = 0;
-
-    for (int k = -kRadius; k <= kRadius; k++) {
-      const double weight = gaussianKernelComponent[k + kRadius];
-      const size_t pixel = mirrorPixel(j + k, height);
-
-      rWeightedAvg += weight * tempPic.red(i, pixel);
-      gWeightedAvg += weight * tempPic.green(i, pixel);
-      bWeightedAvg += weight * tempPic.blue(i, pixel);
-    }
-
-    this->set(i, j, rWeightedAvg, gWeightedAvg, bWeightedAvg, 255);
-  });
+  {
+    Timer passTimer("vertical blur pass");
+    process2dInParallel(height, 1, [&](int, int j) {
+      std::vector<uint32_t> acc(rowBytes, 0);
+
+      for (int k = -kRadius; k <= kRadius; k++) {
+        const int srcY = edgePixel(j + k, height);
+        accumulateRow(acc.data(), &tempValues[srcY * rowBytes],
+                      kernel[k + kRadius], rowBytes);
+      }
+
+      storeRow(&_values[j * rowBytes], acc.data(), rowBytes);
+    }, "vertical blur worker");
+  }
 }
@@ -0,0 +1,358 @@
+#include "../include/inflate.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// codes up to this length decode with one lookup, longer ones fall back to a
+// canonical code walk. 10 bits covers nearly every literal/length code
+constexpr int FAST_BITS = 10;
+constexpr int MAX_BITS = 15;
+
+constexpr uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35,
+    43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+constexpr uchar LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4,
+    4, 4, 4, 5, 5, 5, 5, 0 };
+constexpr uint16_t DIST_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+constexpr uchar DIST_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9,
+    9, 10, 10, 11, 11, 12, 12, 13, 13 };
+constexpr uchar CODE_LENGTH_ORDER[19]
+    = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+class BitReader {
+public:
+    BitReader(uchar const* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    // keeps at least 56 bits buffered, reading zeros past the end so a
+    // truncated stream can be detected afterwards with overrun()
+    void refill()
+    {
+        while (m_count <= 56) {
+            uint64_t const byte = m_pos < m_size ? m_data[m_pos] : 0;
+            m_bits |= byte << m_count;
+            ++m_pos;
+            m_count += 8;
+        }
+    }
+
+    unsigned peek() const { return static_cast<unsigned>(m_bits); }
+
+    void consume(int n)
+    {
+        m_bits >>= n;
+        m_count -= n;
+    }
+
+    unsigned get(int n)
+    {
+        refill();
+        unsigned const value = m_bits & ((1ull << n) - 1);
+        consume(n);
+        return value;
+    }
+
+    // drops the bits up to the next byte boundary and hands back the byte
+    // position, rewinding over whole bytes that were buffered but not used
+    size_t alignToByte()
+    {
+        consume(m_count & 7);
+        size_t const pos = m_pos - m_count / 8;
+        m_bits = 0;
+        m_count = 0;
+        m_pos = pos;
+        return pos;
+    }
+
+    void skipTo(size_t pos) { m_pos = pos; }
+
+    bool overrun() const { return m_pos - m_count / 8 > m_size; }
+
+private:
+    uchar const* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    uint64_t m_bits = 0;
+    int m_count = 0;
+};
+
+struct Huffman {
+    std::array<uint16_t, MAX_BITS + 1> counts {};
+    std::array<uint16_t, 288> symbols {};
+    // (symbol << 4) | length for codes of at most FAST_BITS, 0 otherwise
+    std::array<uint16_t, 1 << FAST_BITS> fast {};
+};
+
+unsigned reverseBits(unsigned code, int length)
+{
+    unsigned reversed = 0;
+    for (int i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    return reversed;
+}
+
+bool buildHuffman(Huffman& huffman, uchar const* lengths, int numSymbols)
+{
+    huffman.counts.fill(0);
+    huffman.fast.fill(0);
+
+    for (int i = 0; i < numSymbols; ++i) {
+        ++huffman.counts[lengths[i]];
+    }
+    huffman.counts[0] = 0;
+
+    // more codes than the lengths can hold; incomplete codes are allowed
+    int left = 1;
+    for (int len = 1; len <= MAX_BITS; ++len) {
+        left = (left << 1) - huffman.counts[len];
+        if (left < 0)
+            return false;
+    }
+
+    std::array<uint16_t, MAX_BITS + 2> offsets {};
+    std::array<unsigned, MAX_BITS + 1> nextCode {};
+    unsigned code = 0;
+    for (int len = 1; len <= MAX_BITS; ++len) {
+        offsets[len + 1] = offsets[len] + huffman.counts[len];
+        code = (code + huffman.counts[len - 1]) << 1;
+        nextCode[len] = code;
+    }
+    nextCode[1] = 0;
+
+    for (int symbol = 0; symbol < numSymbols; ++symbol) {
+        int const len = lengths[symbol];
+        if (len == 0)
+            continue;
+
+        huffman.symbols[offsets[len]++] = symbol;
+
+        if (len <= FAST_BITS) {
+            unsigned const reversed = reverseBits(nextCode[len], len);
+            for (unsigned k = reversed; k < (1u << FAST_BITS); k += 1u << len) {
+                huffman.fast[k] = static_cast<uint16_t>((symbol << 4) | len);
+            }
+        }
+        ++nextCode[len];
+    }
+
+    return true;
+}
+
+// -1 for a bit pattern that is not a code
+int decodeSymbol(BitReader& reader, Huffman const& huffman)
+{
+    reader.refill();
+    unsigned bits = reader.peek();
+
+    uint16_t const entry = huffman.fast[bits & ((1u << FAST_BITS) - 1)];
+    if (entry != 0) {
+        reader.consume(entry & 15);
+        return entry >> 4;
+    }
+
+    // canonical decode, one bit at a time
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int len = 1; len <= MAX_BITS; ++len) {
+        code |= bits & 1;
+        bits >>= 1;
+
+        int const count = huffman.counts[len];
+        if (code - count < first) {
+            reader.consume(len);
+            return huffman.symbols[index + (code - first)];
+        }
+
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+Huffman const& fixedLiteralCodes()
+{
+    static Huffman const huffman = [] {
+        std::array<uchar, 288> lengths {};
+        std::fill(lengths.begin(), lengths.begin() + 144, 8);
+        std::fill(lengths.begin() + 144, lengths.begin() + 256, 9);
+        std::fill(lengths.begin() + 256, lengths.begin() + 280, 7);
+        std::fill(lengths.begin() + 280, lengths.end(), 8);
+        Huffman h;
+        buildHuffman(h, lengths.data(), 288);
+        return h;
+    }();
+    return huffman;
+}
+
+Huffman const& fixedDistanceCodes()
+{
+    static Huffman const huffman = [] {
+        std::array<uchar, 30> lengths {};
+        lengths.fill(5);
+        Huffman h;
+        buildHuffman(h, lengths.data(), 30);
+        return h;
+    }();
+    return huffman;
+}
+
+bool readDynamicCodes(BitReader& reader, Huffman& literals, Huffman& distances)
+{
+    int const numLiterals = reader.get(5) + 257;
+    int const numDistances = reader.get(5) + 1;
+    int const numCodeLengths = reader.get(4) + 4;
+
+    if (numLiterals > 286 || numDistances > 30)
+        return false;
+
+    std::array<uchar, 19> codeLengthLengths {};
+    for (int i = 0; i < numCodeLengths; ++i) {
+        codeLengthLengths[CODE_LENGTH_ORDER[i]] = reader.get(3);
+    }
+
+    Huffman codeLengths;
+    if (!buildHuffman(codeLengths, codeLengthLengths.data(), 19))
+        return false;
+
+    std::array<uchar, 286 + 30> lengths {};
+    int const total = numLiterals + numDistances;
+
+    for (int i = 0; i < total;) {
+        int const symbol = decodeSymbol(reader, codeLengths);
+        if (symbol < 0)
+            return false;
+
+        if (symbol < 16) {
+            lengths[i++] = symbol;
+            continue;
+        }
+
+        int repeat = 0;
+        uchar value = 0;
+        if (symbol == 16) {
+            if (i == 0)
+                return false;
+            value = lengths[i - 1];
+            repeat = 3 + reader.get(2);
+        } else if (symbol == 17) {
+            repeat = 3 + reader.get(3);
+        } else {
+            repeat = 11 + reader.get(7);
+        }
+
+        if (i + repeat > total)
+            return false;
+        std::memset(&lengths[i], value, repeat);
+        i += repeat;
+    }
+
+    // the end-of-block code must exist
+    if (lengths[256] == 0)
+        return false;
+
+    return buildHuffman(literals, lengths.data(), numLiterals)
+        && buildHuffman(distances, lengths.data() + numLiterals, numDistances);
+}
+
+bool inflateBlock(BitReader& reader, Huffman const& literals, Huffman const& distances,
+    std::vector<uchar>& out, size_t& outPos)
+{
+    for (;;) {
+        int const symbol = decodeSymbol(reader, literals);
+
+        if (symbol < 256) {
+            if (symbol < 0 || reader.overrun())
+                return false;
+            if (outPos == out.size())
+                out.resize(out.size() * 2 + 1024);
+            out[outPos++] = symbol;
+            continue;
+        }
+
+        if (symbol == 256)
+            return !reader.overrun();
+
+        int const lengthIdx = symbol - 257;
+        if (lengthIdx >= 29)
+            return false;
+        size_t const length = LENGTH_BASE[lengthIdx] + reader.get(LENGTH_EXTRA[lengthIdx]);
+
+        int const distIdx = decodeSymbol(reader, distances);
+        if (distIdx < 0 || distIdx >= 30)
+            return false;
+        size_t const dist = DIST_BASE[distIdx] + reader.get(DIST_EXTRA[distIdx]);
+
+        if (dist > outPos || reader.overrun())
+            return false;
+        if (outPos + length > out.size())
+            out.resize(out.size() * 2 + length);
+
+        uchar* const dst = &out[outPos];
+        uchar const* src = dst - dist;
+        if (dist >= length) {
+            std::memcpy(dst, src, length);
+        } else if (dist == 1) {
+            std::memset(dst, *src, length);
+        } else {
+            // overlapping copy repeats the last dist bytes
+            for (size_t i = 0; i < length; ++i) {
+                dst[i] = src[i];
+            }
+        }
+        outPos += length;
+    }
+}
+
+bool inflateRaw(uchar const* in, size_t size, std::vector<uchar>& out, size_t sizeHint)
+{
+    BitReader reader(in, size);
+    size_t outPos = out.size();
+    out.resize(outPos + (sizeHint ? sizeHint : 4 * size + 1024));
+
+    Huffman literals;
+    Huffman distances;
+    bool isFinal = false;
+
+    while (!isFinal) {
+        isFinal = reader.get(1);
+        unsigned const type = reader.get(2);
+        bool ok = false;
+
+        if (type == 0) {
+            size_t const pos = reader.alignToByte();
+            if (pos + 4 > size)
+                return false;
+
+            unsigned const length = in[pos] | (in[pos + 1] << 8);
+            unsigned const invLength = in[pos + 2] | (in[pos + 3] << 8);
+            if ((length ^ 0xffff) != invLength || pos + 4 + length > size)
+                return false;
+
+            if (outPos + length > out.size())
+                out.resize(out.size() * 2 + length);
+            std::memcpy(out.data() + outPos, in + pos + 4, length);
+            outPos += length;
+            reader.skipTo(pos + 4 + length);
+            ok = true;
+        } else if (type == 1) {
+            ok = inflateBlock(reader, fixedLiteralCodes(), fixedDistanceCodes(), out, outPos);
+        } else if (type == 2) {
+            ok = readDynamicCodes(reader, literals, distances)
+                && inflateBlock(reader, literals, distances, out, outPos);
+        }
+
+        if (!ok)
+            return false;
+    }
+
+    out.resize(outPos);
+    return true;
+}
@@ -1772,7 +1772,7 @@ static unsigned encodeLZ77(uivector *out, Hash *hash, const unsigned char *in,
  */
 
 static unsigned deflateNoCompression(ucvector *out, const unsigned char *data,
-                                     size_t datasize) {
+                                     size_t datasize, unsigned finish) {
   /*non compressed deflate block data: 1 bit BFINAL,2 bits BTYPE,(5 bits): it
   jumps to start of next byte, 2 bytes LEN, 2 bytes NLEN, LEN bytes literal
   DATA*/
@@ -1783,7 +1783,7 @@ static unsigned deflateNoCompression(ucvector *out, const unsigned char *data,
     unsigned BFINAL, BTYPE, LEN, NLEN;
     unsigned char firstbyte;
 
-    BFINAL = (i == numdeflateblocks - 1);
+    BFINAL = finish && (i == numdeflateblocks - 1);
     BTYPE = 0;
 
     firstbyte =
@@ -2174,16 +2174,17 @@ static unsigned deflateFixed(ucvector *out, size_t *bp, Hash *hash,
 
 static unsigned lodepng_deflatev(ucvector *out, const unsigned char *in,
                                  size_t insize,
-                                 const LodePNGCompressSettings *settings) {
+                                 const LodePNGCompressSettings *settings,
+                                 unsigned finish) {
   unsigned error = 0;
-  size_t i, blocksize, numdeflateblocks;
+  size_t i, blocksize = 0, numdeflateblocks;
   size_t bp = 0; /*the bit pointer*/
   Hash hash;
 
   if (settings->btype > 2)
     return 61;
   else if (settings->btype == 0)
-    return deflateNoCompression(out, in, insize);
+    error = deflateNoCompression(out, in, insize, finish);
   else if (settings->btype == 1)
     blocksize = insize;
   else /*if(settings->btype == 2)*/
@@ -2196,28 +2197,40 @@ static unsigned lodepng_deflatev(ucvector *out, const unsigned char *in,
       blocksize = 262144;
   }
 
-  numdeflateblocks = (insize + blocksize - 1) / blocksize;
-  if (numdeflateblocks == 0)
-    numdeflateblocks = 1;
+  if (settings->btype != 0) {
+    numdeflateblocks = (insize + blocksize - 1) / blocksize;
+    if (numdeflateblocks == 0)
+      numdeflateblocks = 1;
 
-  error = hash_init(&hash, settings->windowsize);
-  if (error)
-    return error;
+    error = hash_init(&hash, settings->windowsize);
+    if (error)
+      return error;
 
-  for (i = 0; i != numdeflateblocks && !error; ++i) {
-    unsigned final = (i == numdeflateblocks - 1);
-    size_t start = i * blocksize;
-    size_t end = start + blocksize;
-    if (end > insize)
-      end = insize;
+    for (i = 0; i != numdeflateblocks && !error; ++i) {
+      unsigned final = finish && (i == numdeflateblocks - 1);
+      size_t start = i * blocksize;
+      size_t end = start + blocksize;
+      if (end > insize)
+        end = insize;
+
+      if (settings->btype == 1)
+        error = deflateFixed(out, &bp, &hash, in, start, end, settings, final);
+      else if (settings->btype == 2)
+        error = deflateDynamic(out, &bp, &hash, in, start, end, settings, final);
+    }
 
-    if (settings->btype == 1)
-      error = deflateFixed(out, &bp, &hash, in, start, end, settings, final);
-    else if (settings->btype == 2)
-      error = deflateDynamic(out, &bp, &hash, in, start, end, settings, final);
+    hash_cleanup(&hash);
   }
 
-  hash_cleanup(&hash);
+  /*sync flush: an empty non-final stored block pads the stream to a byte
+  boundary so more deflate data can be appended after it*/
+  if (!error && !finish) {
+    addBitsToStream(&bp, out, 0, 3);
+    ucvector_push_back(out, 0);
+    ucvector_push_back(out, 0);
+    ucvector_push_back(out, 255);
+    ucvector_push_back(out, 255);
+  }
 
   return error;
 }
@@ -2228,7 +2241,19 @@ unsigned lodepng_deflate(unsigned char **out, size_t *outsize,
   unsigned error;
   ucvector v;
   ucvector_init_buffer(&v, *out, *outsize);
-  error = lodepng_deflatev(&v, in, insize, settings);
+  error = lodepng_deflatev(&v, in, insize, settings, 1);
+  *out = v.data;
+  *outsize = v.size;
+  return error;
+}
+
+unsigned lodepng_deflate_flush(unsigned char **out, size_t *outsize,
+                               const unsigned char *in, size_t insize,
+                               const LodePNGCompressSettings *settings) {
+  unsigned error;
+  ucvector v;
+  ucvector_init_buffer(&v, *out, *outsize);
+  error = lodepng_deflatev(&v, in, insize, settings, 0);
   *out = v.data;
   *outsize = v.size;
   return error;
@@ -1,32 +1,220 @@
 #include "../include/Timer.h"
 #include "../include/atlasPic.h"
+#include "../include/batch.h"
 #include "../include/config.h"
+#include "../include/dither.h"
 #include "../include/gaussianBlur.h"
+#include "../include/mosaicConfig.h"
 #include "../include/picture.h"
 #include "../include/quantizePic.h"
+#include "../include/rawImage.h"
+#include "../include/server.h"
 #include "../include/texturePic.h"
 #include "../include/util.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
-int main()
+void printUsage()
 {
-    Timer::global();
-    Picture srcPic("./srcPics/garden.png");
+    std::cerr << "usage: main [options] [input.png|<dir>]...\n"
+                 "       main [options] --serve <socket path>\n"
+                 "  one input file writes to --output, several inputs or a directory write\n"
+                 "  <stem>_textured.<ext> files into the --output directory. --serve answers\n"
+                 "  render requests on a Unix domain socket, see server.h\n"
+                 "options:\n"
+                 "  --format png|ppm|pam|rgba  --output <path>|-  --config <file>\n"
+                 "  --mode textured|quantized  quantized fills each block with one palette\n"
+                 "                       color instead of a texture, see --palette-size. One\n"
+                 "                       input only, written as PNG to a file\n"
+                 "  --trace <file.json>  write a Chrome trace of every stage and worker thread\n"
+                 "                       for Perfetto (ui.perfetto.dev), not in --serve mode\n"
+                 "  --diff-threshold <x>  --blur-radius <n>  --block-size <n>\n"
+                 "  --resize-factor <x>  --textures-dir <dir>  --texture-cache <file>\n"
+                 "  --dither none|floyd_steinberg|sierra_lite|jarvis|bayer|blue_noise\n"
+                 "  --metric oklab|weighted_oklab|ciede2000|cam16_ucs  --palette-size <n>\n"
+                 "  settings are described in mosaicConfig.h, flags override the config file\n";
+}
+
+// "--block-size" -> "block_size"
+std::string settingKey(std::string const& flag)
+{
+    std::string key = flag.substr(2);
+    std::replace(key.begin(), key.end(), '-', '_');
+    return key;
+}
+
+// the blurred and shrunk input, one pixel per block of the output
+Bitmap prepareBitmap(std::string const& path, MosaicConfig const& config)
+{
+    Picture srcPic(path);
+
+    srcPic.gaussianBlur(config.blurRadius);
+    Picture minPic = srcPic.bilinearResize(config.effectiveResizeFactor());
+    return minPic.getBitmap();
+}
+
+// does nothing for an empty path. A failed trace only warns, the image is
+// already written
+void writeTrace(std::string const& path)
+{
+    if (path.empty())
+        return;
+
+    std::ofstream ofs(path);
+    Timer::writeChromeTrace(ofs);
+    if (!ofs)
+        std::cerr << "failed to write trace file: " << path << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    OutputFormat format = OutputFormat::Png;
+    std::string outPath;
+    std::string socketPath;
+    std::string configPath;
+    std::string tracePath;
+    std::string mode = "textured";
+    std::vector<std::pair<std::string, std::string>> settings;
+    std::vector<std::string> inputArgs;
+    MosaicConfig config;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string const arg = argv[i];
+
+            if (arg.rfind("--", 0) != 0) {
+                inputArgs.push_back(arg);
+                continue;
+            }
+
+            if (i + 1 >= argc) {
+                printUsage();
+                return 1;
+            }
+
+            std::string const value = argv[++i];
+            if (arg == "--format") {
+                format = parseOutputFormat(value);
+            } else if (arg == "--output") {
+                outPath = value;
+            } else if (arg == "--serve") {
+                socketPath = value;
+            } else if (arg == "--config") {
+                configPath = value;
+            } else if (arg == "--trace") {
+                tracePath = value;
+            } else if (arg == "--mode") {
+                if (value != "textured" && value != "quantized")
+                    throw std::invalid_argument("unknown mode: " + value);
+                mode = value;
+            } else {
+                settings.emplace_back(settingKey(arg), value);
+            }
+        }
+
+        if (!configPath.empty()) {
+            loadConfigFile(config, configPath);
+        }
+        for (auto const& [key, value] : settings) {
+            setConfigValue(config, key, value);
+        }
+    } catch (std::invalid_argument const& e) {
+        std::cerr << e.what() << '\n';
+        printUsage();
+        return 1;
+    }
+
+    bool const isBatch = inputArgs.size() > 1
+        || (inputArgs.size() == 1 && std::filesystem::is_directory(inputArgs[0]));
+
+    if (isBatch && outPath == "-") {
+        std::cerr << "batch mode writes one file per input, --output must be a directory\n";
+        return 1;
+    }
+
+    bool const isQuantized = mode == "quantized";
+    if (isQuantized
+        && (isBatch || !socketPath.empty() || format != OutputFormat::Png || outPath == "-")) {
+        std::cerr << "quantized mode takes one input and writes a PNG file\n";
+        return 1;
+    }
+
+    if (outPath.empty()) {
+        outPath = isBatch ? "./outputPics"
+            : isQuantized ? "./outputPics/quantizedPic.png"
+                          : "./outputPics/texturedPic" + fileExtension(format);
+    }
+
+    std::string const inputPath = inputArgs.empty() ? "./srcPics/garden.png" : inputArgs[0];
+
+    // a bad input or texture directory ends the run with its message
+    try {
+        Timer::global();
+
+        // needs no textures
+        if (isQuantized) {
+            Bitmap const bitmap = prepareBitmap(inputPath, config);
+            if (bitmap.m_width == 0 || bitmap.m_height == 0)
+                throw std::runtime_error("image is too small for a single block");
+
+            createQuantizedPic(bitmap, config, outPath);
+            Timer::printData();
+            clrspc::print_clamp_stats();
+            writeTrace(tracePath);
+            return 0;
+        }
+
+        std::vector<Bitmap> validTextures;
+        std::vector<clrspc::Lab> textureAvgColors;
+
+        getTextureData(validTextures, textureAvgColors, config);
+        if (textureAvgColors.empty())
+            throw std::runtime_error("no usable textures in " + config.texturesDir);
+
+        if (!socketPath.empty()) {
+            runServer(socketPath, validTextures, textureAvgColors, config);
+            return 1;
+        }
+
+        if (isBatch) {
+            std::vector<std::string> const inputs = collectBatchInputs(inputArgs);
+            if (inputs.empty()) {
+                std::cerr << "no .png inputs found\n";
+                return 1;
+            }
 
-    srcPic.gaussianBlur(GAUSSIAN_BLUR_RADIUS);
-    Picture minPic = srcPic.bilinearResize(ONE_SIXTEENTH);
-    Bitmap bitmap = minPic.getBitmap();
+            int const failures
+                = runBatch(inputs, outPath, format, validTextures, textureAvgColors, config);
+            Timer::printData();
+            clrspc::print_clamp_stats();
+            writeTrace(tracePath);
+            return failures == 0 ? 0 : 1;
+        }
 
-    std::vector<Bitmap> validTextures;
-    std::vector<clrspc::Lab> textureAvgColors;
+        Bitmap bitmap = prepareBitmap(inputPath, config);
 
-    getTextureData(validTextures, textureAvgColors);
-    auto const textureLookupTable = buildLookupTable(bitmap, textureAvgColors);
+        auto const textureLookupTable
+            = buildDitheredLookupTable(bitmap, textureAvgColors, config.dither, config.metric);
+        if (textureLookupTable.empty() || textureLookupTable[0].empty())
+            throw std::runtime_error("image is too small for a single block");
 
-    createTexturedPic(textureLookupTable, validTextures);
-    // createQuantizedPic(bitmap);
-    // createAtlasPic(validTextures);
+        createTexturedPic(textureLookupTable, validTextures, outPath, format, config.blockSize);
+        // createAtlasPic(validTextures, config.blockSize);
 
-    Timer::printData();
+        // keep stdout clean when the image is piped out through it
+        std::ostream& report = outPath == "-" ? std::cerr : std::cout;
+        Timer::printData(report);
+        clrspc::print_clamp_stats(report);
+        writeTrace(tracePath);
+        return 0;
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
 }
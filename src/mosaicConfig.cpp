@@ -0,0 +1,104 @@
+#include "../include/mosaicConfig.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// the textures are 16 px, past this every texel is just a flat square
+constexpr int MAX_BLOCK_SIZE = 256;
+
+int parseInt(std::string const& key, std::string const& value, int min, int max)
+{
+    size_t end = 0;
+    int parsed = 0;
+    try {
+        parsed = std::stoi(value, &end);
+    } catch (std::exception const&) {
+        end = 0;
+    }
+
+    if (end == 0 || end != value.size() || parsed < min || parsed > max) {
+        throw std::invalid_argument(key + " must be a whole number from " + std::to_string(min)
+            + " to " + std::to_string(max) + ", got \"" + value + "\"");
+    }
+    return parsed;
+}
+
+float parseFloat(std::string const& key, std::string const& value)
+{
+    size_t end = 0;
+    float parsed = 0;
+    try {
+        parsed = std::stof(value, &end);
+    } catch (std::exception const&) {
+        end = 0;
+    }
+
+    if (end == 0 || end != value.size())
+        throw std::invalid_argument(key + " must be a number, got \"" + value + "\"");
+    return parsed;
+}
+
+std::string trim(std::string const& text)
+{
+    size_t const first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return "";
+    size_t const last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+void setConfigValue(MosaicConfig& config, std::string const& key, std::string const& value)
+{
+    if (key == "diff_threshold") {
+        config.diffThreshold = parseFloat(key, value);
+        if (config.diffThreshold < 0)
+            throw std::invalid_argument("diff_threshold can't be negative");
+    } else if (key == "blur_radius") {
+        config.blurRadius = parseInt(key, value, 0, 1000);
+    } else if (key == "block_size") {
+        config.blockSize = parseInt(key, value, 1, MAX_BLOCK_SIZE);
+    } else if (key == "resize_factor") {
+        config.resizeFactor = parseFloat(key, value);
+        if (!(config.resizeFactor > 0 && config.resizeFactor <= 1))
+            throw std::invalid_argument("resize_factor must be in (0, 1]");
+    } else if (key == "textures_dir") {
+        config.texturesDir = value;
+    } else if (key == "texture_cache") {
+        config.textureCachePath = value;
+    } else if (key == "dither") {
+        config.dither = parseDitherMethod(value);
+    } else if (key == "metric") {
+        config.metric = parseColorMetric(value);
+    } else if (key == "palette_size") {
+        config.paletteSize = parseInt(key, value, 0, 256);
+    } else {
+        throw std::invalid_argument("unknown setting: " + key);
+    }
+}
+
+void loadConfigFile(MosaicConfig& config, std::string const& path)
+{
+    std::ifstream ifs(path);
+    if (!ifs)
+        throw std::invalid_argument("failed to open config file: " + path);
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(ifs, line); ++lineNumber) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        size_t const equals = line.find('=');
+        if (equals == std::string::npos) {
+            throw std::invalid_argument(
+                path + ":" + std::to_string(lineNumber) + ": expected key = value");
+        }
+
+        try {
+            setConfigValue(config, trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+        } catch (std::invalid_argument const& e) {
+            throw std::invalid_argument(path + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+}
@@ -0,0 +1,232 @@
+#include "../include/palette.h"
+#include "../include/Timer.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+constexpr int MAX_ITERATIONS = 24;
+// squared OkLab distance under which every centroid counts as settled
+constexpr float CONVERGED_SHIFT = 1e-8f;
+// points per k-means job. The partial sums of the jobs are added up in job
+// order, so the palette doesn't depend on the number of threads
+constexpr size_t CHUNK_POINTS = 2048;
+
+// histogram bins as a structure of arrays, so the distance loops vectorize
+struct Points {
+    std::vector<float> l;
+    std::vector<float> a;
+    std::vector<float> b;
+    std::vector<float> weight;
+
+    size_t size() const { return weight.size(); }
+    float coord(size_t i, int axis) const { return axis == 0 ? l[i] : axis == 1 ? a[i] : b[i]; }
+};
+
+// points order[begin, end) of the median cut
+struct Box {
+    size_t begin;
+    size_t end;
+    // weighted sum of squared distances to the box's mean
+    double error;
+    // the axis the points spread along the most
+    int axis;
+};
+
+Box measureBox(Points const& points, std::vector<size_t> const& order, size_t begin, size_t end)
+{
+    double weight = 0;
+    std::array<double, 3> sum {};
+    std::array<double, 3> sumSquares {};
+
+    for (size_t k = begin; k < end; ++k) {
+        size_t const i = order[k];
+        weight += points.weight[i];
+        for (int axis = 0; axis < 3; ++axis) {
+            double const c = points.coord(i, axis);
+            sum[axis] += points.weight[i] * c;
+            sumSquares[axis] += points.weight[i] * c * c;
+        }
+    }
+
+    Box box { begin, end, 0, 0 };
+    double widest = -1;
+    for (int axis = 0; axis < 3; ++axis) {
+        double const spread = std::max(0.0, sumSquares[axis] - sum[axis] * sum[axis] / weight);
+        box.error += spread;
+        if (spread > widest) {
+            widest = spread;
+            box.axis = axis;
+        }
+    }
+
+    return box;
+}
+
+// splits the box with the largest error at the weighted median of its widest
+// axis until there are numColors boxes, and returns their weighted means
+std::vector<std::array<float, 3>> medianCut(Points const& points, int numColors)
+{
+    Timer timer("median cut");
+    std::vector<size_t> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<Box> boxes = { measureBox(points, order, 0, order.size()) };
+
+    while (boxes.size() < static_cast<size_t>(numColors)) {
+        auto const largest = std::max_element(boxes.begin(), boxes.end(),
+            [](Box const& x, Box const& y) { return x.error < y.error; });
+        if (largest->error <= 0)
+            break;
+
+        Box const box = *largest;
+        std::sort(order.begin() + box.begin, order.begin() + box.end,
+            [&](size_t i, size_t j) { return points.coord(i, box.axis) < points.coord(j, box.axis); });
+
+        double total = 0;
+        for (size_t k = box.begin; k < box.end; ++k) {
+            total += points.weight[order[k]];
+        }
+
+        // at least one point stays on each side
+        size_t split = box.begin + 1;
+        double below = points.weight[order[box.begin]];
+        while (split < box.end - 1 && below < total / 2) {
+            below += points.weight[order[split]];
+            ++split;
+        }
+
+        *largest = measureBox(points, order, box.begin, split);
+        boxes.push_back(measureBox(points, order, split, box.end));
+    }
+
+    std::vector<std::array<float, 3>> centroids;
+    for (Box const& box : boxes) {
+        std::array<double, 3> sum {};
+        double weight = 0;
+        for (size_t k = box.begin; k < box.end; ++k) {
+            size_t const i = order[k];
+            weight += points.weight[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                sum[axis] += points.weight[i] * points.coord(i, axis);
+            }
+        }
+        centroids.push_back({ float(sum[0] / weight), float(sum[1] / weight),
+            float(sum[2] / weight) });
+    }
+
+    return centroids;
+}
+
+// Lloyd's algorithm with every point weighted by its pixel count. Chunks of
+// points are assigned in parallel; a centroid left without points stays put
+void refineKMeans(Points const& points, std::vector<std::array<float, 3>>& centroids)
+{
+    Timer timer("k-means");
+    size_t const k = centroids.size();
+    size_t const numChunks = (points.size() + CHUNK_POINTS - 1) / CHUNK_POINTS;
+
+    std::vector<float> centerL(k), centerA(k), centerB(k);
+    // per chunk and centroid: weighted L, a, b and the weight
+    std::vector<double> partial(numChunks * k * 4);
+
+    for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+        for (size_t c = 0; c < k; ++c) {
+            centerL[c] = centroids[c][0];
+            centerA[c] = centroids[c][1];
+            centerB[c] = centroids[c][2];
+        }
+        std::fill(partial.begin(), partial.end(), 0);
+
+        process2dInParallel(numChunks, 1, [&](int, int chunk) {
+            std::vector<float> dist(k);
+            double* const sums = &partial[chunk * k * 4];
+            size_t const end = std::min(points.size(), (chunk + 1) * CHUNK_POINTS);
+
+            for (size_t i = chunk * CHUNK_POINTS; i < end; ++i) {
+                float const l = points.l[i];
+                float const a = points.a[i];
+                float const b = points.b[i];
+
+                // branch-free over all centroids, the compiler vectorizes it
+                for (size_t c = 0; c < k; ++c) {
+                    float const dl = l - centerL[c];
+                    float const da = a - centerA[c];
+                    float const db = b - centerB[c];
+                    dist[c] = dl * dl + da * da + db * db;
+                }
+
+                size_t const nearest = std::min_element(dist.begin(), dist.end()) - dist.begin();
+                double const weight = points.weight[i];
+                sums[4 * nearest + 0] += weight * l;
+                sums[4 * nearest + 1] += weight * a;
+                sums[4 * nearest + 2] += weight * b;
+                sums[4 * nearest + 3] += weight;
+            }
+        }, "k-means worker");
+
+        float maxShift = 0;
+        for (size_t c = 0; c < k; ++c) {
+            std::array<double, 4> total {};
+            for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+                for (int v = 0; v < 4; ++v) {
+                    total[v] += partial[(chunk * k + c) * 4 + v];
+                }
+            }
+            if (total[3] == 0)
+                continue;
+
+            std::array<float, 3> const moved
+                = { float(total[0] / total[3]), float(total[1] / total[3]),
+                      float(total[2] / total[3]) };
+            float shift = 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                shift += (moved[axis] - centroids[c][axis]) * (moved[axis] - centroids[c][axis]);
+            }
+            maxShift = std::max(maxShift, shift);
+            centroids[c] = moved;
+        }
+
+        if (maxShift < CONVERGED_SHIFT)
+            break;
+    }
+}
+
+std::vector<clrspc::Lab> generatePalette(std::vector<ColorBin> const& histogram, int numColors)
+{
+    Timer timer("generatePalette");
+    std::vector<clrspc::Lab> palette;
+    if (numColors < 1 || histogram.empty())
+        return palette;
+
+    if (histogram.size() <= static_cast<size_t>(numColors)) {
+        for (ColorBin const& bin : histogram) {
+            palette.push_back(bin.color);
+        }
+        return palette;
+    }
+
+    Points points;
+    for (ColorBin const& bin : histogram) {
+        points.l.push_back(bin.color.l());
+        points.a.push_back(bin.color.a());
+        points.b.push_back(bin.color.b());
+        points.weight.push_back(bin.count);
+    }
+
+    std::vector<std::array<float, 3>> centroids = medianCut(points, numColors);
+    refineKMeans(points, centroids);
+
+    for (auto const& [l, a, b] : centroids) {
+        palette.emplace_back(l, a, b);
+    }
+    return palette;
+}
+
+std::vector<clrspc::Lab> generatePalette(Bitmap const& bitmap, int numColors)
+{
+    return generatePalette(buildColorHistogram(bitmap), numColors);
+}
@@ -2,6 +2,8 @@
 #include "../include/picture.h"
 #include "../include/Color_Space.h"
 #include "../include/Timer.h"
+#include "../include/pngDecoder.h"
+#include "../include/util.h"
 
 #include <algorithm>
 #include <cmath>
@@ -10,6 +12,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -49,6 +52,7 @@ Picture::Picture(const std::vector<std::vector<int>> &grays) {
 
 
 Picture::Picture(const Bitmap &bitmap, const int factor) {
+  Timer timer("Upscale bitmap");
   const int channels = 4;
 
   _width = bitmap.m_width * factor;
@@ -57,23 +61,29 @@ Picture::Picture(const Bitmap &bitmap, const int factor) {
   // Allocate enough space for the expanded image
   _values.resize(_width * _height * channels);
 
-  for (int j = 0; j < bitmap.m_height; j++) {
-    for (int i = 0; i < bitmap.m_width; i++) {
-      auto [r, g, b] = bitmap.get(i, j).get_values();
-
-      // Write the scaled pixels
-      for (int y = 0; y < factor; y++) {
-        for (int x = 0; x < factor; x++) {
-          size_t dstIdx =
-              ((j * factor + y) * _width + (i * factor + x)) * channels;
-          _values[dstIdx] = r;
-          _values[dstIdx + 1] = g;
-          _values[dstIdx + 2] = b;
-          _values[dstIdx + 3] = 255; // Alpha channel
+  const size_t rowBytes = static_cast<size_t>(_width) * channels;
+
+  // Each source row composes its first output row as one factor-wide RGBA run
+  // per pixel, the other factor - 1 rows are copies of it
+  process2dInParallel(
+      bitmap.m_height, 1,
+      [&](int, int j) {
+        const uchar *in = &bitmap.m_bits[Bitmap::CHANNELS * j * bitmap.m_width];
+        uchar *first = &_values[j * factor * rowBytes];
+        uchar *out = first;
+
+        for (int i = 0; i < bitmap.m_width; i++, in += Bitmap::CHANNELS) {
+          const uchar rgba[4] = {in[0], in[1], in[2], 255};
+          for (int x = 0; x < factor; x++, out += channels) {
+            std::memcpy(out, rgba, channels);
+          }
         }
-      }
-    }
-  }
+
+        for (int y = 1; y < factor; y++) {
+          std::memcpy(first + y * rowBytes, first, rowBytes);
+        }
+      },
+      "upscale worker");
 }
 
 
@@ -89,7 +99,7 @@ Bitmap Picture::getBitmap() const {
       const int g = _values[i + 1];
       const int b = _values[i + 2];
 
-      bitmap.set(x, y, clrspc::Rgb(r, g, b));
+      bitmap.set(x, y, clrspc::Rgb::from_bytes(r, g, b));
     }
   }
 
@@ -97,11 +107,64 @@ Bitmap Picture::getBitmap() const {
 }
 
 
-void Picture::save(const std::string &filename) const {
+void Picture::save(const std::string &filename, PngProfile profile) const {
   Timer timer("Saved photo");
-  unsigned error = lodepng::encode(filename.c_str(), _values, _width, _height);
-  if (error != 0)
-    throw std::runtime_error(lodepng_error_text(error));
+  const size_t rowBytes = 4 * _width;
+
+  bool isOpaque = true;
+  for (size_t k = 3; k < _values.size() && isOpaque; k += 4) {
+    isOpaque = _values[k] == 255;
+  }
+
+  // like lodepng's auto_convert, use a palette when the image has few enough
+  // colors and drop the alpha channel when nothing uses it
+  std::unordered_map<uint32_t, uchar> paletteIdx;
+  PngPalette palette;
+  auto pixelKey = [&](size_t k) {
+    return (uint32_t(_values[k]) << 16) | (uint32_t(_values[k + 1]) << 8) |
+           _values[k + 2];
+  };
+
+  for (size_t k = 0; k < _values.size() && isOpaque && palette.size() <= 256;
+       k += 4) {
+    // mosaics are made of long runs, so skip pixels equal to their neighbour
+    if (k >= 4 && std::memcmp(&_values[k], &_values[k - 4], 3) == 0)
+      continue;
+
+    if (paletteIdx.emplace(pixelKey(k), palette.size()).second)
+      palette.push_back({_values[k], _values[k + 1], _values[k + 2]});
+  }
+
+  if (isOpaque && !palette.empty() && palette.size() <= 256) {
+    encodePng(filename, _width, _height, PngColorType::Palette,
+              [&](int y, uchar *row) {
+                const size_t start = y * rowBytes;
+                for (int x = 0; x < _width; x++) {
+                  const size_t k = start + 4 * x;
+                  row[x] = x > 0 && std::memcmp(&_values[k], &_values[k - 4], 3) == 0
+                               ? row[x - 1]
+                               : paletteIdx.at(pixelKey(k));
+                }
+              },
+              profile, palette);
+  } else if (isOpaque) {
+    encodePng(filename, _width, _height, PngColorType::Rgb,
+              [&](int y, uchar *row) {
+                const uchar *src = &_values[y * rowBytes];
+                for (int x = 0; x < _width; x++) {
+                  row[3 * x] = src[4 * x];
+                  row[3 * x + 1] = src[4 * x + 1];
+                  row[3 * x + 2] = src[4 * x + 2];
+                }
+              },
+              profile);
+  } else {
+    encodePng(filename, _width, _height, PngColorType::Rgba,
+              [&](int y, uchar *row) {
+                std::memcpy(row, &_values[y * rowBytes], rowBytes);
+              },
+              profile);
+  }
 }
 
 
@@ -150,13 +213,14 @@ void Picture::set(int x, int y, int red, int green, int blue, int alpha) {
 
 
 Picture::Picture(const std::string &filename) {
-  Timer("initialize photo");
-  unsigned int w, h;
-  unsigned error = lodepng::decode(_values, w, h, filename);
-  if (error != 0)
-    throw std::runtime_error(lodepng_error_text(error));
-  _width = w;
-  _height = h;
+  Timer timer("initialize photo");
+  decodePng(filename, _values, _width, _height, 4);
+}
+
+
+Picture::Picture(const std::vector<unsigned char> &pngFile) {
+  Timer timer("initialize photo");
+  decodePng(pngFile, _values, _width, _height, 4);
 }
 
 int clampVal(float val) { return std::clamp(int(std::round(val)), 0, 255); };
@@ -169,8 +233,7 @@ Picture Picture::bilinearResize(float factor) const {
 
   // returns a rgb struct not associated with the ImageEditor class.
   auto getRgb = [&](int x, int y) -> const clrspc::Rgb {
-    return {static_cast<float>(red(x, y)), static_cast<float>(green(x, y)),
-            static_cast<float>(blue(x, y))};
+    return clrspc::Rgb::from_bytes(red(x, y), green(x, y), blue(x, y));
   };
 
   const size_t inHeight = _height;
@@ -217,9 +280,10 @@ Picture Picture::bilinearResize(float factor) const {
       auto calcRgb = [&](const clrspc::Rgb &A, const clrspc::Rgb &B,
                          const clrspc::Rgb &C,
                          const clrspc::Rgb &D) -> clrspc::Rgb {
-        return {interpolate(A.r(), B.r(), C.r(), D.r()),
-                interpolate(A.g(), B.g(), C.g(), D.g()),
-                interpolate(A.b(), B.b(), C.b(), D.b())};
+        // a weighted average of bytes can't leave the byte range
+        return clrspc::Rgb::unchecked(interpolate(A.r(), B.r(), C.r(), D.r()),
+                                      interpolate(A.g(), B.g(), C.g(), D.g()),
+                                      interpolate(A.b(), B.b(), C.b(), D.b()));
       };
 
       const auto [r, g, b] = calcRgb(A, B, C, D).get_values();
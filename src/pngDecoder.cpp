@@ -0,0 +1,292 @@
+#include "../include/pngDecoder.h"
+#include "../include/Timer.h"
+#include "../include/inflate.h"
+#include "../include/lodepng.h"
+#include "../include/pngEncoder.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct PngInfo {
+    int width = 0;
+    int height = 0;
+    int bitDepth = 0;
+    int colorType = 0;
+    int interlace = 0;
+    std::vector<std::pair<uchar const*, size_t>> idats;
+};
+
+unsigned readBigEndian32(uchar const* data)
+{
+    return (unsigned(data[0]) << 24) | (unsigned(data[1]) << 16) | (unsigned(data[2]) << 8)
+        | data[3];
+}
+
+// collects the header fields and IDAT chunks, false if the file is malformed
+bool readPngChunks(std::vector<uchar> const& file, PngInfo& info)
+{
+    static constexpr uchar signature[] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    if (file.size() < 8 || std::memcmp(file.data(), signature, 8) != 0)
+        return false;
+
+    size_t pos = 8;
+    while (pos + 12 <= file.size()) {
+        size_t const length = readBigEndian32(&file[pos]);
+        char const* type = reinterpret_cast<char const*>(&file[pos + 4]);
+        uchar const* data = &file[pos + 8];
+
+        if (length > file.size() - pos - 12)
+            return false;
+
+        if (std::memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+            info.width = readBigEndian32(data);
+            info.height = readBigEndian32(data + 4);
+            info.bitDepth = data[8];
+            info.colorType = data[9];
+            info.interlace = data[12];
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            info.idats.emplace_back(data, length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+
+        pos += length + 12;
+    }
+
+    return info.width > 0 && info.height > 0 && !info.idats.empty();
+}
+
+// a sync flush ends with an empty stored block, so the next chunk starts on a
+// deflate block boundary and can be inflated on its own
+bool endsWithSyncFlush(std::pair<uchar const*, size_t> const& idat)
+{
+    static constexpr uchar marker[] = { 0, 0, 255, 255 };
+    return idat.second >= 5 && std::memcmp(idat.first + idat.second - 4, marker, 4) == 0;
+}
+
+// inflates every IDAT chunk on its own thread. Only valid when the chunks are
+// split at sync flushes; the adler32 of the result catches any chunk that only
+// looked like it was
+bool inflateIdatsInParallel(PngInfo const& info, std::vector<uchar>& out, size_t expectedSize)
+{
+    size_t const numChunks = info.idats.size();
+    if (numChunks < 2 || info.idats[0].second < 2 || info.idats.back().second < 4)
+        return false;
+
+    for (size_t i = 0; i + 1 < numChunks; ++i) {
+        if (!endsWithSyncFlush(info.idats[i]))
+            return false;
+    }
+
+    std::vector<std::vector<uchar>> parts(numChunks);
+    std::vector<char> succeeded(numChunks, false);
+
+    process2dInParallel(numChunks, 1, [&](int, int i) {
+        auto [data, size] = info.idats[i];
+        bool const isFirst = i == 0;
+        bool const isLast = i == static_cast<int>(numChunks) - 1;
+
+        // drop the zlib header and checksum, and finish the non-last parts with
+        // an empty final fixed-Huffman block
+        std::vector<uchar> stream(data + (isFirst ? 2 : 0), data + size - (isLast ? 4 : 0));
+        if (!isLast) {
+            stream.insert(stream.end(), { 0x03, 0x00 });
+        }
+
+        succeeded[i]
+            = inflateRaw(stream.data(), stream.size(), parts[i], expectedSize / numChunks);
+    }, "inflate worker");
+
+    if (std::find(succeeded.begin(), succeeded.end(), false) != succeeded.end())
+        return false;
+
+    out.clear();
+    for (auto const& part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+    }
+
+    auto const& [lastData, lastSize] = info.idats.back();
+    return updateAdler32(1, out.data(), out.size()) == readBigEndian32(lastData + lastSize - 4);
+}
+
+// inflates the zlib stream with inflateRaw, false if it is not a plain zlib
+// stream or its checksum does not match
+bool inflateZlib(std::vector<uchar> const& zlibData, std::vector<uchar>& out, size_t expectedSize)
+{
+    if (zlibData.size() < 6)
+        return false;
+
+    unsigned const cmf = zlibData[0];
+    unsigned const flg = zlibData[1];
+    bool const isDeflate = (cmf & 15) == 8 && (cmf >> 4) <= 7;
+    bool const hasDictionary = flg & 32;
+    if (!isDeflate || hasDictionary || (cmf * 256 + flg) % 31 != 0)
+        return false;
+
+    out.clear();
+    return inflateRaw(zlibData.data() + 2, zlibData.size() - 6, out, expectedSize)
+        && updateAdler32(1, out.data(), out.size())
+        == readBigEndian32(&zlibData[zlibData.size() - 4]);
+}
+
+void inflateIdats(PngInfo const& info, std::vector<uchar>& out, size_t expectedSize)
+{
+    if (inflateIdatsInParallel(info, out, expectedSize))
+        return;
+
+    std::vector<uchar> zlibData;
+    for (auto const& [data, size] : info.idats) {
+        zlibData.insert(zlibData.end(), data, data + size);
+    }
+
+    if (inflateZlib(zlibData, out, expectedSize))
+        return;
+
+    // lodepng decides whether the data is really broken and how to report it
+
+    unsigned char* inflated = nullptr;
+    size_t inflatedSize = 0;
+    unsigned const error = lodepng_zlib_decompress(&inflated, &inflatedSize, zlibData.data(),
+        zlibData.size(), &lodepng_default_decompress_settings);
+
+    if (error == 0) {
+        out.assign(inflated, inflated + inflatedSize);
+    }
+    std::free(inflated);
+
+    if (error != 0)
+        throw std::runtime_error(lodepng_error_text(error));
+}
+
+// reverses one of the five PNG filter types in place. prev is the
+// reconstructed scanline above, all zeros for the first row
+void unfilterScanline(uchar* row, uchar const* prev, size_t length, size_t bpp, int type)
+{
+    switch (type) {
+    case 0:
+        break;
+    case 1:
+        for (size_t i = bpp; i < length; ++i)
+            row[i] += row[i - bpp];
+        break;
+    case 2:
+        for (size_t i = 0; i < length; ++i)
+            row[i] += prev[i];
+        break;
+    case 3:
+        for (size_t i = 0; i < bpp; ++i)
+            row[i] += prev[i] >> 1;
+        for (size_t i = bpp; i < length; ++i)
+            row[i] += (row[i - bpp] + prev[i]) >> 1;
+        break;
+    case 4:
+        for (size_t i = 0; i < bpp; ++i)
+            row[i] += prev[i];
+        for (size_t i = bpp; i < length; ++i)
+            row[i] += paethPredictor(row[i - bpp], prev[i], prev[i - bpp]);
+        break;
+    default:
+        throw std::runtime_error(lodepng_error_text(36)); // illegal filter type
+    }
+}
+
+// RGB and RGBA need no palette, bit unpacking or deinterlacing, which is all
+// the mosaic's inputs ever use
+bool canDecodeFast(PngInfo const& info)
+{
+    return info.bitDepth == 8 && info.interlace == 0
+        && (info.colorType == 2 || info.colorType == 6);
+}
+
+void decodePng(std::vector<uchar> const& file, std::vector<uchar>& pixels, int& width, int& height,
+    int channels)
+{
+    Timer timer("decode PNG");
+    PngInfo info;
+    if (!readPngChunks(file, info) || !canDecodeFast(info)) {
+        unsigned w, h;
+        pixels.clear();
+        unsigned const error
+            = lodepng::decode(pixels, w, h, file, channels == 4 ? LCT_RGBA : LCT_RGB, 8);
+        if (error != 0)
+            throw std::runtime_error(lodepng_error_text(error));
+        width = w;
+        height = h;
+        return;
+    }
+
+    size_t const srcChannels = info.colorType == 6 ? 4 : 3;
+    size_t const rowBytes = srcChannels * info.width;
+
+    std::vector<uchar> scanlines;
+    {
+        Timer inflateTimer("inflate");
+        inflateIdats(info, scanlines, (rowBytes + 1) * info.height);
+    }
+    if (scanlines.size() < (rowBytes + 1) * info.height)
+        throw std::runtime_error(lodepng_error_text(91)); // not enough image data
+
+    width = info.width;
+    height = info.height;
+    pixels.resize(static_cast<size_t>(channels) * width * height);
+
+    Timer unfilterTimer("unfilter");
+    std::vector<uchar> prev(rowBytes, 0);
+    std::vector<uchar> curr(rowBytes);
+
+    for (int y = 0; y < height; ++y) {
+        uchar const* filtered = &scanlines[(rowBytes + 1) * y];
+        uchar* const out = &pixels[static_cast<size_t>(channels) * width * y];
+
+        // same layout: reconstruct directly into the output, the row above is
+        // already there
+        if (srcChannels == static_cast<size_t>(channels)) {
+            uchar const* above = y > 0 ? out - rowBytes : prev.data();
+            std::memcpy(out, filtered + 1, rowBytes);
+            unfilterScanline(out, above, rowBytes, srcChannels, filtered[0]);
+            continue;
+        }
+
+        std::memcpy(curr.data(), filtered + 1, rowBytes);
+        unfilterScanline(curr.data(), prev.data(), rowBytes, srcChannels, filtered[0]);
+
+        if (channels == 4) {
+            for (int x = 0; x < width; ++x) {
+                std::memcpy(&out[4 * x], &curr[3 * x], 3);
+                out[4 * x + 3] = 255;
+            }
+        } else {
+            for (int x = 0; x < width; ++x) {
+                std::memcpy(&out[3 * x], &curr[4 * x], 3);
+            }
+        }
+
+        std::swap(prev, curr);
+    }
+}
+
+void decodePng(std::string const& filename, std::vector<uchar>& pixels, int& width, int& height,
+    int channels)
+{
+    std::vector<uchar> file;
+    unsigned const error = [&] {
+        Timer timer("read file");
+        return lodepng::load_file(file, filename);
+    }();
+    if (error != 0)
+        throw std::runtime_error(lodepng_error_text(error));
+
+    decodePng(file, pixels, width, height, channels);
+}
+
+Bitmap decodePngBitmap(std::string const& filename)
+{
+    Bitmap bitmap(0, 0);
+    decodePng(filename, bitmap.m_bits, bitmap.m_width, bitmap.m_height, Bitmap::CHANNELS);
+    return bitmap;
+}
@@ -0,0 +1,387 @@
+#include "../include/pngEncoder.h"
+#include "../include/Timer.h"
+#include "../include/lodepng.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// stripes smaller than this lose too much ratio at the flush boundaries
+constexpr size_t MIN_STRIPE_BYTES = 1 << 18;
+
+constexpr unsigned ADLER_BASE = 65521;
+
+// largest number of bytes that can be summed before the adler sums overflow
+constexpr size_t ADLER_NMAX = 5552;
+
+struct ProfileSettings {
+    // filter types tried on every scanline; the one with the smallest residual wins
+    std::vector<int> filterTypes;
+    LodePNGCompressSettings zlib;
+};
+
+struct Stripe {
+    std::vector<uchar> deflated;
+    unsigned adler = 1;
+    size_t rawSize = 0;
+    unsigned error = 0;
+};
+
+unsigned updateAdler32(unsigned adler, uchar const* data, size_t length)
+{
+    unsigned s1 = adler & 0xffff;
+    unsigned s2 = adler >> 16;
+
+    while (length > 0) {
+        size_t const amount = std::min(length, ADLER_NMAX);
+        length -= amount;
+
+        for (size_t i = 0; i < amount; ++i) {
+            s1 += data[i];
+            s2 += s1;
+        }
+        data += amount;
+
+        s1 %= ADLER_BASE;
+        s2 %= ADLER_BASE;
+    }
+
+    return (s2 << 16) | s1;
+}
+
+// checksum of the concatenation of two buffers from their separate checksums,
+// as zlib's adler32_combine
+unsigned combineAdler32(unsigned adlerA, unsigned adlerB, size_t lengthB)
+{
+    unsigned const rem = lengthB % ADLER_BASE;
+    unsigned s1 = adlerA & 0xffff;
+    unsigned s2 = static_cast<unsigned>((static_cast<uint64_t>(rem) * s1) % ADLER_BASE);
+
+    s1 += (adlerB & 0xffff) + ADLER_BASE - 1;
+    s2 += (adlerA >> 16) + (adlerB >> 16) + ADLER_BASE - rem;
+
+    if (s1 >= ADLER_BASE)
+        s1 -= ADLER_BASE;
+    if (s1 >= ADLER_BASE)
+        s1 -= ADLER_BASE;
+    if (s2 >= (ADLER_BASE << 1))
+        s2 -= (ADLER_BASE << 1);
+    if (s2 >= ADLER_BASE)
+        s2 -= ADLER_BASE;
+
+    return (s2 << 16) | s1;
+}
+
+int paethPredictor(int a, int b, int c)
+{
+    int const p = a + b - c;
+    int const pa = std::abs(p - a);
+    int const pb = std::abs(p - b);
+    int const pc = std::abs(p - c);
+
+    if (pa <= pb && pa <= pc)
+        return a;
+    return pb <= pc ? b : c;
+}
+
+// applies one of the five PNG filter types to a scanline. prev is the
+// unfiltered scanline above, all zeros for the first row of the image
+void filterScanline(
+    uchar* out, uchar const* row, uchar const* prev, size_t length, size_t bpp, int type)
+{
+    switch (type) {
+    case 0:
+        std::memcpy(out, row, length);
+        break;
+    case 1:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = row[i];
+        for (size_t i = bpp; i < length; ++i)
+            out[i] = row[i] - row[i - bpp];
+        break;
+    case 2:
+        for (size_t i = 0; i < length; ++i)
+            out[i] = row[i] - prev[i];
+        break;
+    case 3:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = row[i] - (prev[i] >> 1);
+        for (size_t i = bpp; i < length; ++i)
+            out[i] = row[i] - ((row[i - bpp] + prev[i]) >> 1);
+        break;
+    case 4:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = row[i] - prev[i];
+        for (size_t i = bpp; i < length; ++i)
+            out[i] = row[i] - paethPredictor(row[i - bpp], prev[i], prev[i - bpp]);
+        break;
+    }
+}
+
+// picks the filter with the smallest sum of absolute signed residuals, the
+// same heuristic lodepng and libpng use by default
+void filterScanlineAdaptive(uchar* out, uchar* attempt, uchar const* row, uchar const* prev,
+    size_t length, size_t bpp, std::vector<int> const& filterTypes)
+{
+    size_t bestSum = std::numeric_limits<size_t>::max();
+
+    for (int const type : filterTypes) {
+        filterScanline(attempt, row, prev, length, bpp, type);
+
+        size_t sum = 0;
+        for (size_t i = 0; i < length; ++i) {
+            sum += std::abs(static_cast<signed char>(attempt[i]));
+        }
+
+        if (sum < bestSum) {
+            bestSum = sum;
+            out[0] = type;
+            std::memcpy(out + 1, attempt, length);
+        }
+    }
+}
+
+// rowBytes is the unfiltered length of a scanline
+ProfileSettings getProfileSettings(PngProfile profile, size_t rowBytes)
+{
+    ProfileSettings settings { { 0, 1, 2, 3, 4 }, lodepng_default_compress_settings };
+
+    switch (profile) {
+    case PngProfile::Fastest:
+        // without filtering, a block row repeats as a copy of the scanline
+        // above, so the window has to reach it: one row plus its filter byte.
+        // Rows past 32K bytes only get the matches within a row
+        settings.filterTypes = { 0 };
+        settings.zlib.btype = 1;
+        settings.zlib.windowsize = 256;
+        while (settings.zlib.windowsize < 32768 && settings.zlib.windowsize <= rowBytes + 1) {
+            settings.zlib.windowsize *= 2;
+        }
+        settings.zlib.nicematch = 32;
+        settings.zlib.lazymatching = 0;
+        break;
+    case PngProfile::Balanced:
+        break;
+    case PngProfile::Smallest:
+        settings.zlib.windowsize = 32768;
+        settings.zlib.nicematch = 258;
+        break;
+    }
+
+    return settings;
+}
+
+void encodeStripe(Stripe& stripe, int startRow, int endRow, size_t rowBytes, size_t bpp,
+    ScanlineSource const& source, ProfileSettings const& settings, bool isLast)
+{
+    std::vector<uchar> filtered((rowBytes + 1) * (endRow - startRow));
+    std::vector<uchar> prev(rowBytes, 0);
+    std::vector<uchar> curr(rowBytes);
+    std::vector<uchar> attempt(rowBytes);
+
+    if (startRow > 0) {
+        source(startRow - 1, prev.data());
+    }
+
+    for (int y = startRow; y < endRow; ++y) {
+        source(y, curr.data());
+        uchar* const out = &filtered[(rowBytes + 1) * (y - startRow)];
+        filterScanlineAdaptive(
+            out, attempt.data(), curr.data(), prev.data(), rowBytes, bpp, settings.filterTypes);
+        std::swap(prev, curr);
+    }
+
+    stripe.rawSize = filtered.size();
+    stripe.adler = updateAdler32(1, filtered.data(), filtered.size());
+
+    unsigned char* deflated = nullptr;
+    size_t deflatedSize = 0;
+    stripe.error = isLast
+        ? lodepng_deflate(
+              &deflated, &deflatedSize, filtered.data(), filtered.size(), &settings.zlib)
+        : lodepng_deflate_flush(
+              &deflated, &deflatedSize, filtered.data(), filtered.size(), &settings.zlib);
+
+    if (stripe.error == 0) {
+        stripe.deflated.assign(deflated, deflated + deflatedSize);
+    }
+    std::free(deflated);
+}
+
+void writeBigEndian32(std::vector<uchar>& out, unsigned value)
+{
+    out.push_back(value >> 24);
+    out.push_back(value >> 16);
+    out.push_back(value >> 8);
+    out.push_back(value);
+}
+
+void writeChunk(std::ostream& os, char const* type, std::vector<uchar> const& data)
+{
+    std::vector<uchar> chunk;
+    chunk.reserve(data.size() + 12);
+
+    writeBigEndian32(chunk, data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    writeBigEndian32(chunk, lodepng_crc32(&chunk[4], data.size() + 4));
+
+    os.write(reinterpret_cast<char const*>(chunk.data()), chunk.size());
+}
+
+size_t bytesPerPixel(PngColorType colorType)
+{
+    switch (colorType) {
+    case PngColorType::Rgb:
+        return 3;
+    case PngColorType::Palette:
+        return 1;
+    case PngColorType::Rgba:
+        return 4;
+    }
+    return 4;
+}
+
+void encodePng(std::ostream& os, int width, int height, PngColorType colorType,
+    ScanlineSource const& source, PngProfile profile, PngPalette const& palette)
+{
+    Timer timer("encode PNG");
+    if (colorType == PngColorType::Palette && (palette.empty() || palette.size() > 256))
+        throw std::runtime_error("palette images need between 1 and 256 palette entries");
+
+    size_t const bpp = bytesPerPixel(colorType);
+    size_t const rowBytes = bpp * width;
+    ProfileSettings const settings = getProfileSettings(profile, rowBytes);
+
+    int const maxStripes = std::max(1u, std::thread::hardware_concurrency());
+    int const rowsPerMinStripe = std::max<size_t>(1, MIN_STRIPE_BYTES / (rowBytes + 1));
+    int const stripeRows = std::max(
+        (height + maxStripes - 1) / maxStripes, std::min(rowsPerMinStripe, std::max(height, 1)));
+    int const numStripes = std::max(1, (height + stripeRows - 1) / stripeRows);
+
+    std::vector<Stripe> stripes(numStripes);
+
+    process2dInParallel(numStripes, 1, [&](int, int s) {
+        int const startRow = s * stripeRows;
+        int const endRow = std::min(height, startRow + stripeRows);
+        encodeStripe(stripes[s], startRow, endRow, rowBytes, bpp, source, settings,
+            s == numStripes - 1);
+    }, "deflate worker");
+
+    for (Stripe const& stripe : stripes) {
+        if (stripe.error != 0)
+            throw std::runtime_error(lodepng_error_text(stripe.error));
+    }
+
+    static constexpr uchar signature[] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    os.write(reinterpret_cast<char const*>(signature), sizeof(signature));
+
+    std::vector<uchar> header;
+    writeBigEndian32(header, width);
+    writeBigEndian32(header, height);
+    header.push_back(8); // bit depth
+    header.push_back(static_cast<uchar>(colorType));
+    header.push_back(0); // compression method
+    header.push_back(0); // filter method
+    header.push_back(0); // no interlace
+    writeChunk(os, "IHDR", header);
+
+    if (colorType == PngColorType::Palette) {
+        std::vector<uchar> entries;
+        for (auto const& [r, g, b] : palette) {
+            entries.insert(entries.end(), { r, g, b });
+        }
+        writeChunk(os, "PLTE", entries);
+    }
+
+    // one IDAT per stripe; the zlib header (deflate, 32K window) goes in front
+    // of the first and the combined checksum after the last
+    unsigned adler = 1;
+    for (int s = 0; s < numStripes; ++s) {
+        std::vector<uchar>& data = stripes[s].deflated;
+        adler = combineAdler32(adler, stripes[s].adler, stripes[s].rawSize);
+
+        if (s == 0) {
+            data.insert(data.begin(), { 0x78, 0x01 });
+        }
+        if (s == numStripes - 1) {
+            writeBigEndian32(data, adler);
+        }
+
+        writeChunk(os, "IDAT", data);
+    }
+
+    writeChunk(os, "IEND", {});
+}
+
+void encodePng(std::string const& filename, int width, int height, PngColorType colorType,
+    ScanlineSource const& source, PngProfile profile, PngPalette const& palette)
+{
+    std::ofstream ofs(filename, std::ios::binary);
+    if (!ofs)
+        throw std::runtime_error("failed to open file for writing: " + filename);
+
+    encodePng(ofs, width, height, colorType, source, profile, palette);
+
+    if (!ofs)
+        throw std::runtime_error("failed to write file: " + filename);
+}
+
+void encodeIndexedPng(std::string const& filename, std::vector<std::vector<int>> const& indices,
+    PngPalette const& palette, int factor, PngProfile profile)
+{
+    Timer timer("Saved photo");
+    int const blocksY = indices.size();
+    int const blocksX = blocksY ? indices[0].size() : 0;
+
+    // only the referenced entries go into the PLTE chunk
+    std::vector<int> remap(palette.size(), -1);
+    PngPalette usedPalette;
+
+    for (auto const& row : indices) {
+        for (int const idx : row) {
+            if (remap[idx] < 0) {
+                remap[idx] = usedPalette.size();
+                usedPalette.push_back(palette[idx]);
+            }
+        }
+    }
+
+    if (usedPalette.size() <= 256) {
+        encodePng(
+            filename, blocksX * factor, blocksY * factor, PngColorType::Palette,
+            [&](int y, uchar* row) {
+                for (int const idx : indices[y / factor]) {
+                    std::memset(row, remap[idx], factor);
+                    row += factor;
+                }
+            },
+            profile, usedPalette);
+    } else {
+        // one factor-wide run of every entry, so a block is a single copy
+        size_t const runBytes = 3 * factor;
+        std::vector<uchar> runs(palette.size() * runBytes);
+        for (size_t idx = 0; idx < palette.size(); ++idx) {
+            for (int x = 0; x < factor; ++x) {
+                std::memcpy(&runs[idx * runBytes + 3 * x], palette[idx].data(), 3);
+            }
+        }
+
+        encodePng(
+            filename, blocksX * factor, blocksY * factor, PngColorType::Rgb,
+            [&](int y, uchar* row) {
+                for (int const idx : indices[y / factor]) {
+                    std::memcpy(row, &runs[idx * runBytes], runBytes);
+                    row += runBytes;
+                }
+            },
+            profile);
+    }
+}
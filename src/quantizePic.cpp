@@ -1,11 +1,14 @@
 #include "../include/quantizePic.h"
 #include "../include/Bitmap.h"
 #include "../include/Color_Space.h"
+#include "../include/palette.h"
 #include "../include/picture.h"
+#include "../include/pngEncoder.h"
 #include "../include/util.h"
 
 #include <algorithm>
 #include <cmath>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -37,19 +40,23 @@ std::vector<clrspc::Lab> getPalletColors()
     return colors;
 }
 
-void createQuantizedPic(Bitmap const& bitmapIn)
+void createQuantizedPic(Bitmap const& bitmapIn, MosaicConfig const& config, std::string const& outPath)
 {
     //   const std::vector<clrspc::Lab> colors = getPalletColors();
-    std::vector<clrspc::Lab> const colors = getQuantizedColors();
-    std::vector<std::vector<int>> const lookupTable = buildLookupTable(bitmapIn, colors);
-
-    Bitmap bitmapOut(bitmapIn.m_width, bitmapIn.m_height);
-
-    process2dInParallel(bitmapIn.m_height, bitmapIn.m_width, [&](int i, int j) {
-        int const texIdx = lookupTable[j][i];
-        bitmapOut.set(i, j, colors[texIdx].to_rgb());
+    std::vector<clrspc::Lab> const colors = config.paletteSize > 0
+        ? generatePalette(bitmapIn, config.paletteSize)
+        : getQuantizedColors();
+    std::vector<std::vector<int>> const lookupTable
+        = buildDitheredLookupTable(bitmapIn, colors, config.dither, config.metric);
+
+    // palette colors are converted once and the image is written straight
+    // from the lookup table. K-means means can land just outside sRGB, so
+    // they're mapped into it rather than clamped
+    PngPalette palette(colors.size());
+    std::transform(colors.begin(), colors.end(), palette.begin(), [](clrspc::Lab const& c) {
+        auto const [r, g, b] = c.to_rgb_in_gamut().get_values();
+        return std::array<uchar, 3> { r, g, b };
     });
 
-    Picture quantPic(bitmapOut, BLOCK_SIZE);
-    quantPic.save("./outputPics/quantizedPic.png");
+    encodeIndexedPng(outPath, lookupTable, palette, config.blockSize);
 }
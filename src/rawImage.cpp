@@ -0,0 +1,167 @@
+#include "../include/rawImage.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#    include <io.h>
+#    define open _open
+#    define write _write
+#    define close _close
+#    define O_BINARY_FLAG _O_BINARY
+#else
+#    include <unistd.h>
+#    define O_BINARY_FLAG 0
+#endif
+
+// bytes composed per write: enough rows that starting the band's workers is
+// cheap next to composing it, without ever buffering a large image
+constexpr size_t BAND_BYTES = 8 << 20;
+
+OutputFormat parseOutputFormat(std::string const& name)
+{
+    if (name == "png")
+        return OutputFormat::Png;
+    if (name == "ppm")
+        return OutputFormat::Ppm;
+    if (name == "pam")
+        return OutputFormat::Pam;
+    if (name == "rgba")
+        return OutputFormat::Rgba;
+
+    throw std::invalid_argument("unknown output format: " + name);
+}
+
+int outputChannels(OutputFormat format)
+{
+    return format == OutputFormat::Png || format == OutputFormat::Ppm ? 3 : 4;
+}
+
+void useBinaryStdout()
+{
+#ifdef _WIN32
+    _setmode(1, _O_BINARY);
+#endif
+}
+
+std::string fileExtension(OutputFormat format)
+{
+    switch (format) {
+    case OutputFormat::Png:
+        return ".png";
+    case OutputFormat::Ppm:
+        return ".ppm";
+    case OutputFormat::Pam:
+        return ".pam";
+    case OutputFormat::Rgba:
+        return ".rgba";
+    }
+    return "";
+}
+
+void writeAll(int fd, uchar const* data, size_t size)
+{
+    while (size > 0) {
+        auto const written = write(fd, data, size);
+
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::string("failed to write image: ") + std::strerror(errno));
+        }
+
+        data += written;
+        size -= written;
+    }
+}
+
+std::string rawHeader(int width, int height, OutputFormat format)
+{
+    switch (format) {
+    case OutputFormat::Ppm:
+        return "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    case OutputFormat::Pam:
+        return "P7\nWIDTH " + std::to_string(width) + "\nHEIGHT " + std::to_string(height)
+            + "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+    case OutputFormat::Rgba: {
+        std::string header = "RGBA";
+        for (uint32_t const value : { uint32_t(width), uint32_t(height) }) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                header.push_back(static_cast<char>(value >> shift));
+            }
+        }
+        return header;
+    }
+    case OutputFormat::Png:
+        break;
+    }
+
+    throw std::invalid_argument("PNG is not a raw output format");
+}
+
+void writeRawBands(int width, int height, OutputFormat format, ScanlineSource const& source,
+    std::function<void(uchar const*, size_t)> const& sink)
+{
+    Timer timer("encode raw image");
+    std::string const header = rawHeader(width, height, format);
+    sink(reinterpret_cast<uchar const*>(header.data()), header.size());
+
+    size_t const rowBytes = static_cast<size_t>(outputChannels(format)) * width;
+    int const bandRows = static_cast<int>(
+        std::clamp<size_t>(BAND_BYTES / std::max<size_t>(rowBytes, 1), 1, std::max(height, 1)));
+    std::vector<uchar> band(rowBytes * bandRows);
+
+    for (int bandY = 0; bandY < height; bandY += bandRows) {
+        int const rows = std::min(bandRows, height - bandY);
+
+        process2dInParallel(rows, 1, [&](int, int j) {
+            source(bandY + j, &band[j * rowBytes]);
+        }, "raw band worker");
+
+        sink(band.data(), rowBytes * rows);
+    }
+}
+
+void writeRawImage(int fd, int width, int height, OutputFormat format, ScanlineSource const& source)
+{
+    writeRawBands(width, height, format, source,
+        [fd](uchar const* data, size_t size) { writeAll(fd, data, size); });
+}
+
+void writeRawImage(std::ostream& os, int width, int height, OutputFormat format,
+    ScanlineSource const& source)
+{
+    writeRawBands(width, height, format, source, [&os](uchar const* data, size_t size) {
+        os.write(reinterpret_cast<char const*>(data), size);
+    });
+}
+
+void saveRawImage(std::string const& path, int width, int height, OutputFormat format,
+    ScanlineSource const& source)
+{
+    if (path == "-") {
+        useBinaryStdout();
+        writeRawImage(1, width, height, format, source);
+        return;
+    }
+
+    int const fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY_FLAG, 0644);
+    if (fd < 0)
+        throw std::runtime_error("failed to open file for writing: " + path);
+
+    try {
+        writeRawImage(fd, width, height, format, source);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    close(fd);
+}
@@ -0,0 +1,284 @@
+#include "../include/server.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+
+void runServer(std::string const&, std::vector<Bitmap> const&, std::vector<clrspc::Lab> const&,
+    MosaicConfig const&)
+{
+    throw std::runtime_error("server mode needs Unix domain sockets");
+}
+
+#else
+
+#    include "../include/Timer.h"
+#    include "../include/picture.h"
+#    include "../include/rawImage.h"
+#    include "../include/texturePic.h"
+
+#    include <cerrno>
+#    include <chrono>
+#    include <csignal>
+#    include <cstring>
+#    include <exception>
+#    include <iomanip>
+#    include <iostream>
+#    include <sstream>
+#    include <sys/socket.h>
+#    include <sys/stat.h>
+#    include <sys/un.h>
+#    include <thread>
+#    include <unistd.h>
+
+// request lines are short; anything longer is not our protocol
+constexpr size_t MAX_LINE_LENGTH = 4096;
+constexpr size_t MAX_UPLOAD_BYTES = size_t(1) << 30;
+constexpr size_t READ_CHUNK = 1 << 16;
+
+// buffered reads and unbuffered writes on a connected socket, which it closes
+class Connection {
+public:
+    explicit Connection(int fd)
+        : m_fd(fd)
+    {
+    }
+
+    ~Connection() { close(m_fd); }
+
+    Connection(Connection const&) = delete;
+    Connection& operator=(Connection const&) = delete;
+
+    // false at the end of the stream or on an overlong line
+    bool readLine(std::string& line)
+    {
+        size_t newline;
+        while ((newline = m_pending.find('\n')) == std::string::npos) {
+            if (m_pending.size() > MAX_LINE_LENGTH || !fill())
+                return false;
+        }
+
+        line.assign(m_pending, 0, newline);
+        m_pending.erase(0, newline + 1);
+        return line.size() <= MAX_LINE_LENGTH;
+    }
+
+    bool readExact(std::vector<uchar>& out, size_t size)
+    {
+        while (m_pending.size() < size) {
+            if (!fill())
+                return false;
+        }
+
+        out.assign(m_pending.begin(), m_pending.begin() + size);
+        m_pending.erase(0, size);
+        return true;
+    }
+
+    bool send(char const* data, size_t size)
+    {
+        while (size > 0) {
+            ssize_t const written = write(m_fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            data += written;
+            size -= written;
+        }
+        return true;
+    }
+
+    bool send(std::string const& data) { return send(data.data(), data.size()); }
+
+private:
+    bool fill()
+    {
+        char chunk[READ_CHUNK];
+        for (;;) {
+            ssize_t const received = read(m_fd, chunk, sizeof(chunk));
+            if (received < 0 && errno == EINTR)
+                continue;
+            if (received <= 0)
+                return false;
+
+            m_pending.append(chunk, received);
+            return true;
+        }
+    }
+
+    int m_fd;
+    std::string m_pending;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+std::string errorLine(std::string message)
+{
+    for (char& c : message) {
+        if (c == '\n' || c == '\r')
+            c = ' ';
+    }
+    return "error " + message + "\n";
+}
+
+// answers one request, false once the connection can't be used any further
+bool handleRequest(Connection& connection, std::string const& line,
+    std::vector<Bitmap> const& validTextures, std::vector<clrspc::Lab> const& textureAvgColors,
+    MosaicConfig const& config)
+{
+    std::istringstream iss(line);
+    std::string command, formatName, source;
+    iss >> command >> formatName >> source;
+
+    if (command != "render" || (source != "path" && source != "bytes"))
+        return connection.send(errorLine("expected: render <format> path|bytes <argument>"));
+
+    std::string inputPath;
+    std::vector<uchar> inputBytes;
+
+    if (source == "path") {
+        std::getline(iss >> std::ws, inputPath);
+        if (inputPath.empty())
+            return connection.send(errorLine("missing input path"));
+    } else {
+        size_t size = 0;
+        // without a valid size the payload can't be skipped, so the
+        // connection is out of sync from here on
+        if (!(iss >> size) || size > MAX_UPLOAD_BYTES) {
+            connection.send(errorLine("invalid payload size"));
+            return false;
+        }
+        if (!connection.readExact(inputBytes, size))
+            return false;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    double decodeMs = 0, matchMs = 0, encodeMs = 0;
+    std::string image;
+
+    try {
+        OutputFormat const format = parseOutputFormat(formatName);
+
+        auto stageStart = std::chrono::steady_clock::now();
+        Picture srcPic = source == "path" ? Picture(inputPath) : Picture(inputBytes);
+        inputBytes = {};
+        decodeMs = millisecondsSince(stageStart);
+
+        stageStart = std::chrono::steady_clock::now();
+        auto const lookupTable = buildTextureLookupTable(srcPic, textureAvgColors, config);
+        if (lookupTable.empty() || lookupTable[0].empty())
+            throw std::runtime_error("image is too small for a single block");
+        matchMs = millisecondsSince(stageStart);
+
+        stageStart = std::chrono::steady_clock::now();
+        std::ostringstream encoded;
+        writeTexturedPic(lookupTable, validTextures, encoded, format, config.blockSize);
+        image = std::move(encoded).str();
+        encodeMs = millisecondsSince(stageStart);
+    } catch (std::exception const& e) {
+        return connection.send(errorLine(e.what()));
+    }
+
+    std::ostringstream header;
+    header << std::fixed << std::setprecision(3) << "ok " << image.size()
+           << " decode_ms=" << decodeMs << " match_ms=" << matchMs << " encode_ms=" << encodeMs
+           << " total_ms=" << millisecondsSince(start) << '\n';
+
+    return connection.send(header.str()) && connection.send(image);
+}
+
+void serveConnection(int fd, std::vector<Bitmap> const& validTextures,
+    std::vector<clrspc::Lab> const& textureAvgColors, MosaicConfig const& config)
+{
+    Timer::nameThread("connection");
+    Connection connection(fd);
+    std::string line;
+
+    while (connection.readLine(line)) {
+        if (line.empty())
+            continue;
+        if (!handleRequest(connection, line, validTextures, textureAvgColors, config))
+            break;
+    }
+}
+
+// removes a socket left behind by a server that is gone. Anything else at the
+// path, a file or a socket someone still listens on, is left alone
+void removeStaleSocket(std::string const& socketPath, sockaddr_un const& address)
+{
+    struct stat info {};
+    if (lstat(socketPath.c_str(), &info) != 0) {
+        if (errno == ENOENT)
+            return;
+        throw std::runtime_error("failed to check socket path " + socketPath + ": "
+            + std::strerror(errno));
+    }
+
+    if (!S_ISSOCK(info.st_mode))
+        throw std::runtime_error("socket path in use: " + socketPath + " is not a socket");
+
+    int const probeFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probeFd < 0)
+        throw std::runtime_error(std::string("failed to create socket: ") + std::strerror(errno));
+    bool const refused
+        = connect(probeFd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0
+        && errno == ECONNREFUSED;
+    close(probeFd);
+
+    if (!refused)
+        throw std::runtime_error("socket path in use: " + socketPath);
+    if (unlink(socketPath.c_str()) != 0 && errno != ENOENT)
+        throw std::runtime_error("failed to remove stale socket " + socketPath + ": "
+            + std::strerror(errno));
+}
+
+void runServer(std::string const& socketPath, std::vector<Bitmap> const& validTextures,
+    std::vector<clrspc::Lab> const& textureAvgColors, MosaicConfig const& config)
+{
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("socket path is too long: " + socketPath);
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    // a client hanging up mid-response must not take the server down with it
+    std::signal(SIGPIPE, SIG_IGN);
+
+    removeStaleSocket(socketPath, address);
+
+    int const listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        throw std::runtime_error(std::string("failed to create socket: ") + std::strerror(errno));
+
+    if (bind(listenFd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0
+        || listen(listenFd, SOMAXCONN) != 0) {
+        std::string const reason = std::strerror(errno);
+        close(listenFd);
+        throw std::runtime_error("failed to listen on " + socketPath + ": " + reason);
+    }
+
+    std::cerr << "listening on " << socketPath << '\n';
+
+    for (;;) {
+        int const fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            std::string const reason = std::strerror(errno);
+            close(listenFd);
+            throw std::runtime_error("failed to accept connection: " + reason);
+        }
+
+        std::thread(serveConnection, fd, std::cref(validTextures), std::cref(textureAvgColors),
+            std::cref(config))
+            .detach();
+    }
+}
+
+#endif
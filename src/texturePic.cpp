@@ -1,12 +1,20 @@
 #include "../include/Color_Space.h"
 #include "../include/Timer.h"
 #include "../include/config.h"
+#include "../include/dither.h"
+#include "../include/mosaicConfig.h"
 #include "../include/picture.h"
+#include "../include/pngDecoder.h"
+#include "../include/pngEncoder.h"
+#include "../include/rawImage.h"
 #include "../include/util.h"
 
+#include <algorithm>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iostream>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -28,24 +36,30 @@ std::vector<std::string> getPaths(const std::string &dir) {
 
 
 std::vector<std::pair<std::string, clrspc::Lab>>
-getValidTexturesWithAvgs(const std::vector<std::string> &paths) {
+getValidTexturesWithAvgs(const std::vector<std::string> &paths,
+                         const float diffThreshold) {
+  Timer timer("filter textures");
   std::vector<std::pair<std::string, clrspc::Lab>> results;
 
   for (const auto &path : paths) {
     Picture texture(path);
     bool isTransparent = false;
 
+    // animated textures stack their frames vertically, only the first is used
+    const int size = std::min(texture.width(), texture.height());
+
     float lAvg = 0, aAvg = 0, bAvg = 0;
 
-    for (size_t j = 0; j < BLOCK_SIZE && !isTransparent; ++j) {
-      for (size_t k = 0; k < BLOCK_SIZE; ++k) {
+    for (int j = 0; j < size && !isTransparent; ++j) {
+      for (int k = 0; k < size; ++k) {
         if (texture.alpha(k, j) != 255) {
           isTransparent = true;
           break;
         }
 
-        auto [l, a, b] = clrspc::Rgb(texture.red(k, j), texture.green(k, j),
-                                     texture.blue(k, j))
+        auto [l, a, b] = clrspc::Rgb::from_bytes(texture.red(k, j),
+                                                 texture.green(k, j),
+                                                 texture.blue(k, j))
                              .to_lab()
                              .get_values();
         lAvg += l;
@@ -54,27 +68,31 @@ getValidTexturesWithAvgs(const std::vector<std::string> &paths) {
       }
     }
 
-    if (isTransparent)
+    if (isTransparent || size == 0)
       continue;
 
-    constexpr float pixelCount = BLOCK_SIZE * BLOCK_SIZE;
+    const float pixelCount = size * size;
     lAvg /= pixelCount;
     aAvg /= pixelCount;
     bAvg /= pixelCount;
 
     clrspc::Lab avg(lAvg, aAvg, bAvg);
 
+    // the threshold is calibrated on a 16x16 sum, larger textures are scaled
+    // down to match
+    const float diffScale = BLOCK_SIZE * BLOCK_SIZE / pixelCount;
     float diff = 0;
-    for (size_t j = 0; j < BLOCK_SIZE && diff < 35; ++j) {
-      for (size_t k = 0; k < BLOCK_SIZE; ++k) {
-        auto color = clrspc::Rgb(texture.red(k, j), texture.green(k, j),
-                                 texture.blue(k, j))
+    for (int j = 0; j < size && diff * diffScale < diffThreshold; ++j) {
+      for (int k = 0; k < size; ++k) {
+        auto color = clrspc::Rgb::from_bytes(texture.red(k, j),
+                                             texture.green(k, j),
+                                             texture.blue(k, j))
                          .to_lab();
         diff += distSquared(avg, color);
       }
     }
 
-    if (diff > DIFF_THRESHOLD)
+    if (diff * diffScale > diffThreshold)
       continue;
 
     results.emplace_back(path, avg);
@@ -84,9 +102,23 @@ getValidTexturesWithAvgs(const std::vector<std::string> &paths) {
 }
 
 
+// written ahead of the entries so a cache built from other settings is
+// rebuilt instead of reused
+constexpr char TEXTURE_CACHE_MAGIC[4] = {'M', 'T', 'C', '2'};
+
+
 void writeTextureCache(
+    const std::string &cachePath, const MosaicConfig &config,
     const std::vector<std::pair<std::string, clrspc::Lab>> &data) {
-  std::ofstream ofs("texture.dat", std::ios::binary);
+  std::ofstream ofs(cachePath, std::ios::binary);
+  const uint32_t dirLen = config.texturesDir.size();
+
+  ofs.write(TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC));
+  ofs.write(reinterpret_cast<const char *>(&config.diffThreshold),
+            sizeof(float));
+  ofs.write(reinterpret_cast<const char *>(&dirLen), sizeof(dirLen));
+  ofs.write(config.texturesDir.data(), dirLen);
+
   for (const auto &[path, color] : data) {
     const auto [l, a, b] = color.get_values();
     const uint32_t len = path.size();
@@ -100,10 +132,32 @@ void writeTextureCache(
 }
 
 
-bool readTextureCache(std::vector<std::string> &paths,
+bool readTextureCacheHeader(std::ifstream &ifs, const MosaicConfig &config) {
+  char magic[sizeof(TEXTURE_CACHE_MAGIC)];
+  float diffThreshold;
+  uint32_t dirLen;
+
+  if (!ifs.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, TEXTURE_CACHE_MAGIC, sizeof(magic)) != 0 ||
+      !ifs.read(reinterpret_cast<char *>(&diffThreshold), sizeof(float)) ||
+      !ifs.read(reinterpret_cast<char *>(&dirLen), sizeof(dirLen)) ||
+      dirLen != config.texturesDir.size())
+    return false;
+
+  std::string texturesDir(dirLen, '\0');
+  if (!ifs.read(&texturesDir[0], dirLen))
+    return false;
+
+  return diffThreshold == config.diffThreshold &&
+         texturesDir == config.texturesDir;
+}
+
+
+bool readTextureCache(const std::string &cachePath, const MosaicConfig &config,
+                      std::vector<std::string> &paths,
                       std::vector<clrspc::Lab> &colors) {
-  std::ifstream ifs("texture.dat", std::ios::binary);
-  if (!ifs)
+  std::ifstream ifs(cachePath, std::ios::binary);
+  if (!ifs || !readTextureCacheHeader(ifs, config))
     return false;
 
   while (ifs.peek() != EOF) {
@@ -129,13 +183,53 @@ bool readTextureCache(std::vector<std::string> &paths,
 }
 
 
-std::vector<Bitmap> buildBitmaps(const std::vector<std::string> &validPaths) {
+// the texture's first frame as a blockSize square: box filtered when it
+// shrinks and nearest neighbour when it grows, which keeps the pixel art crisp
+Bitmap fitTexture(const Bitmap &texture, const int blockSize) {
+  const int size = std::min(texture.m_width, texture.m_height);
+  if (texture.m_width == blockSize)
+    return texture;
+
+  Bitmap fitted(blockSize, blockSize);
+
+  for (int y = 0; y < blockSize; ++y) {
+    const int y0 = y * size / blockSize;
+    const int y1 = std::max(y0 + 1, (y + 1) * size / blockSize);
+
+    for (int x = 0; x < blockSize; ++x) {
+      const int x0 = x * size / blockSize;
+      const int x1 = std::max(x0 + 1, (x + 1) * size / blockSize);
+      int sum[Bitmap::CHANNELS] = {};
+
+      for (int sy = y0; sy < y1; ++sy) {
+        for (int sx = x0; sx < x1; ++sx) {
+          for (int c = 0; c < Bitmap::CHANNELS; ++c) {
+            sum[c] += texture.m_bits[Bitmap::CHANNELS * (sy * texture.m_width + sx) + c];
+          }
+        }
+      }
+
+      const int count = (y1 - y0) * (x1 - x0);
+      for (int c = 0; c < Bitmap::CHANNELS; ++c) {
+        fitted.m_bits[Bitmap::CHANNELS * (y * blockSize + x) + c] =
+            (sum[c] + count / 2) / count;
+      }
+    }
+  }
+
+  return fitted;
+}
+
+
+std::vector<Bitmap> buildBitmaps(const std::vector<std::string> &validPaths,
+                                 const int blockSize) {
+  Timer timer("load textures");
   const size_t numTiles = validPaths.size();
   std::vector<Bitmap> validTextures;
 
   for (size_t i = 0; i < numTiles; i++) {
-    Bitmap bitmap = Picture(validPaths[i]).getBitmap();
-    validTextures.push_back(bitmap);
+    validTextures.push_back(
+        fitTexture(decodePngBitmap(validPaths[i]), blockSize));
   }
 
   return validTextures;
@@ -149,7 +243,7 @@ calcTextureAvgColors(const std::vector<Bitmap> &validTextures) {
 
   for (size_t i = 0; i < numValidTiles; i++) {
     Bitmap bitmap(validTextures[i]);
-    avgColors.emplace_back(getAverage(bitmap, 0, 0));
+    avgColors.emplace_back(getAverage(bitmap, 0, 0, bitmap.m_width));
   }
 
   return avgColors;
@@ -157,13 +251,19 @@ calcTextureAvgColors(const std::vector<Bitmap> &validTextures) {
 
 
 void getTextureData(std::vector<Bitmap> &validTextures,
-                    std::vector<clrspc::Lab> &textureAvgColors) {
+                    std::vector<clrspc::Lab> &textureAvgColors,
+                    const MosaicConfig &config) {
   Timer timer("getTextureData");
   std::vector<std::string> validPaths;
 
-  if (!readTextureCache(validPaths, textureAvgColors)) {
-    auto allPaths = getPaths("./blocks");
-    auto textureData = getValidTexturesWithAvgs(allPaths);
+  if (!readTextureCache(config.textureCachePath, config, validPaths,
+                        textureAvgColors)) {
+    validPaths.clear();
+    textureAvgColors.clear();
+
+    auto allPaths = getPaths(config.texturesDir);
+    auto textureData =
+        getValidTexturesWithAvgs(allPaths, config.diffThreshold);
 
     validPaths.reserve(textureData.size());
     textureAvgColors.reserve(textureData.size());
@@ -173,10 +273,10 @@ void getTextureData(std::vector<Bitmap> &validTextures,
       textureAvgColors.push_back(lab);
     }
 
-    writeTextureCache(textureData);
-    validTextures = buildBitmaps(validPaths);
+    writeTextureCache(config.textureCachePath, config, textureData);
+    validTextures = buildBitmaps(validPaths, config.blockSize);
   } else {
-    validTextures = buildBitmaps(validPaths);
+    validTextures = buildBitmaps(validPaths, config.blockSize);
     if (validTextures.size() != textureAvgColors.size()) {
       throw std::runtime_error("Cached texture data is corrupt.");
     }
@@ -184,37 +284,135 @@ void getTextureData(std::vector<Bitmap> &validTextures,
 }
 
 
-void createTexturedPic(const std::vector<std::vector<int>> &textureLookupTable,
-                       const std::vector<Bitmap> &validTextures) {
+// copies row texY of every tile in lookupRow into row. FixedBlock is the tile
+// size when it is one of the specialized sizes, so every per-tile copy is a
+// fixed-length kernel the compiler unrolls; 0 reads the size from blockSize
+template <int FixedBlock>
+void copyTileRows(const std::vector<int> &lookupRow,
+                  const std::vector<Bitmap> &validTextures, const int texY,
+                  const int channels, const int blockSize, uchar *row) {
+  const int size = FixedBlock ? FixedBlock : blockSize;
+
+  for (const int texIdx : lookupRow) {
+    const Bitmap &texture = validTextures[texIdx];
+
+    if (channels == 3) {
+      std::memcpy(row, &texture.m_bits[Bitmap::CHANNELS * texY * texture.m_width],
+                  Bitmap::CHANNELS * size);
+    } else if constexpr (FixedBlock != 0) {
+      texture.getRgbaRow<FixedBlock>(0, texY, row);
+    } else {
+      texture.getRgbaRow(0, texY, size, row);
+    }
+
+    row += channels * size;
+  }
+}
+
+
+template <int FixedBlock>
+ScanlineSource tiledScanlines(const std::vector<std::vector<int>> &textureLookupTable,
+                              const std::vector<Bitmap> &validTextures,
+                              const int channels, const int blockSize) {
+  return [&textureLookupTable, &validTextures, channels, blockSize](int y, uchar *row) {
+    const int size = FixedBlock ? FixedBlock : blockSize;
+    copyTileRows<FixedBlock>(textureLookupTable[y / size], validTextures,
+                             y % size, channels, size, row);
+  };
+}
+
+
+// the common resource pack sizes get their own compiled kernels, any other
+// size takes the generic loop
+ScanlineSource texturedScanlines(const std::vector<std::vector<int>> &textureLookupTable,
+                                 const std::vector<Bitmap> &validTextures,
+                                 const int channels, const int blockSize) {
+  switch (blockSize) {
+  case 8:
+    return tiledScanlines<8>(textureLookupTable, validTextures, channels, blockSize);
+  case 16:
+    return tiledScanlines<16>(textureLookupTable, validTextures, channels, blockSize);
+  case 32:
+    return tiledScanlines<32>(textureLookupTable, validTextures, channels, blockSize);
+  case 64:
+    return tiledScanlines<64>(textureLookupTable, validTextures, channels, blockSize);
+  default:
+    return tiledScanlines<0>(textureLookupTable, validTextures, channels, blockSize);
+  }
+}
+
 
-  const int blocksY = textureLookupTable.size();
-  const int blocksX = textureLookupTable[0].size();
-  const int outWidth = blocksX * BLOCK_SIZE;
-  const int outHeight = blocksY * BLOCK_SIZE;
+Picture composeTexturedPic(const std::vector<std::vector<int>> &textureLookupTable,
+                           const std::vector<Bitmap> &validTextures,
+                           const int blockSize) {
+  Timer timer("createTexturedPic");
+  const int outWidth = textureLookupTable[0].size() * blockSize;
+  const int outHeight = textureLookupTable.size() * blockSize;
 
   Picture texturedPic(outWidth, outHeight, 0, 0, 0);
+  const ScanlineSource scanlines =
+      texturedScanlines(textureLookupTable, validTextures, 4, blockSize);
 
-  process2dInParallel(blocksY, blocksX, [&](int blockX, int blockY) {
-    Timer timer("createTexturedPic");
-    const int texIdx = textureLookupTable[blockY][blockX];
-    const Bitmap &texture = validTextures[texIdx];
+  process2dInParallel(outHeight, 1, [&](int, int y) {
+    scanlines(y, &texturedPic._values[4 * y * outWidth]);
+  }, "compose worker");
 
-    const int baseX = blockX * BLOCK_SIZE;
-    const int baseY = blockY * BLOCK_SIZE;
+  return texturedPic;
+}
 
-    for (int y = 0; y < BLOCK_SIZE; ++y) {
-      const int outY = baseY + y;
 
-      // Grab 16 RGB pixels (one row), convert to 8 RGBA in one shot
-      std::array<uchar, 64> rgbaRow = texture.getSixteen(0, y);
+std::vector<std::vector<int>>
+buildTextureLookupTable(Picture &srcPic,
+                        const std::vector<clrspc::Lab> &textureAvgColors,
+                        const MosaicConfig &config) {
+  srcPic.gaussianBlur(config.blurRadius);
+  const Picture minPic = srcPic.bilinearResize(config.effectiveResizeFactor());
+  const Bitmap bitmap = minPic.getBitmap();
 
-      // Destination index in final RGBA buffer
-      const int dst = 4 * (outY * outWidth + baseX);
+  return buildDitheredLookupTable(bitmap, textureAvgColors, config.dither,
+                                  config.metric);
+}
 
-      // Copy 16 RGBA pixels (64 bytes)
-      std::memcpy(&texturedPic._values[dst], rgbaRow.data(), 64);
-    }
-  });
 
-  texturedPic.save("./outputPics/texturedPic.png");
+// streams the mosaic straight from the textures into the output, the full
+// size image is never built
+void createTexturedPic(const std::vector<std::vector<int>> &textureLookupTable,
+                       const std::vector<Bitmap> &validTextures,
+                       const std::string &outPath, const OutputFormat format,
+                       const int blockSize) {
+  Timer timer("Saved photo");
+  const int outWidth = textureLookupTable[0].size() * blockSize;
+  const int outHeight = textureLookupTable.size() * blockSize;
+
+  const ScanlineSource scanlines = texturedScanlines(
+      textureLookupTable, validTextures, outputChannels(format), blockSize);
+
+  if (format == OutputFormat::Png && outPath == "-") {
+    useBinaryStdout();
+    encodePng(std::cout, outWidth, outHeight, PngColorType::Rgb, scanlines);
+    if (!std::cout.flush())
+      throw std::runtime_error("failed to write the image to stdout");
+  } else if (format == OutputFormat::Png) {
+    encodePng(outPath, outWidth, outHeight, PngColorType::Rgb, scanlines);
+  } else {
+    saveRawImage(outPath, outWidth, outHeight, format, scanlines);
+  }
+}
+
+
+void writeTexturedPic(const std::vector<std::vector<int>> &textureLookupTable,
+                      const std::vector<Bitmap> &validTextures,
+                      std::ostream &os, const OutputFormat format,
+                      const int blockSize) {
+  Timer timer("Saved photo");
+  const int outWidth = textureLookupTable[0].size() * blockSize;
+  const int outHeight = textureLookupTable.size() * blockSize;
+
+  const ScanlineSource scanlines = texturedScanlines(
+      textureLookupTable, validTextures, outputChannels(format), blockSize);
+
+  if (format == OutputFormat::Png)
+    encodePng(os, outWidth, outHeight, PngColorType::Rgb, scanlines);
+  else
+    writeRawImage(os, outWidth, outHeight, format, scanlines);
 }
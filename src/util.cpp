@@ -1,6 +1,7 @@
 #include "../include/util.h"
 #include "../include/Color_Space.h"
 #include "../include/Timer.h"
+#include "../include/colorHistogram.h"
 #include "../include/picture.h"
 
 #include <algorithm>
@@ -30,13 +31,13 @@ std::array<float, 3> multiplyMatrix(
     return result;
 }
 
-clrspc::Lab getAverage(Bitmap const& bitmap, int originX, int originY)
+clrspc::Lab getAverage(Bitmap const& bitmap, int originX, int originY, int blockSize)
 {
     float lStar = 0.0;
     float aStar = 0.0;
     float bStar = 0.0;
-    int const maxX = std::min(originX + BLOCK_SIZE, bitmap.m_width);
-    int const maxY = std::min(originY + BLOCK_SIZE, bitmap.m_height);
+    int const maxX = std::min(originX + blockSize, bitmap.m_width);
+    int const maxY = std::min(originY + blockSize, bitmap.m_height);
     int const numPx = (maxX - originX) * (maxY - originY);
 
     for (int x = originX; x < maxX; ++x) {
@@ -62,9 +63,7 @@ size_t findClosestColorIdx(
     float minDist = std::numeric_limits<float>::max();
 
     for (size_t i = 0; i < quantColors.size(); ++i) {
-        float const currDist = distSquared(targetColor, quantColors[i]); // fast
-        // const float currDist = targetColor.diff_cie_2000(quantColors[i]); //
-        // slow
+        float const currDist = distSquared(targetColor, quantColors[i]);
 
         if (currDist < minDist) {
             minDist = currDist;
@@ -76,19 +75,40 @@ size_t findClosestColorIdx(
 }
 
 std::vector<std::vector<int>> buildLookupTable(
-    Bitmap const& bitmap, std::vector<clrspc::Lab> const& quantColors)
+    Bitmap const& bitmap, std::vector<clrspc::Lab> const& quantColors, ColorMetric metric)
 {
     Timer timer("buildLookupTable");
     std::vector<std::vector<int>> lookupTable(bitmap.m_height, std::vector<int>(bitmap.m_width));
 
-    for (int i = 0; i < bitmap.m_width; i++) {
+    ColorMatcher const matcher(quantColors, metric);
+
+    // a search costs about as much as scanning a few hundred words of the
+    // distinct color bitset, so a tiny bitmap is cheaper to match pixel by pixel
+    if (size_t(bitmap.m_width) * bitmap.m_height < DistinctColors::NUM_WORDS / 256) {
         for (int j = 0; j < bitmap.m_height; j++) {
+            uchar const* px = &bitmap.m_bits[Bitmap::CHANNELS * j * bitmap.m_width];
+            for (int i = 0; i < bitmap.m_width; i++, px += Bitmap::CHANNELS) {
+                lookupTable[j][i] = matcher.closest(unpackRgb(packRgb(px)).to_lab());
+            }
+        }
+        return lookupTable;
+    }
+
+    // pixels of the same color always match the same entry, so every distinct
+    // color is searched once and the result copied to all of its pixels
+    DistinctColors const distinct = findDistinctColors(bitmap);
+    std::vector<int> closest(distinct.colors.size());
 
-            int const texIdx = findClosestColorIdx(bitmap.get(i, j).to_lab(), quantColors);
+    process2dInParallel(closest.size(), 1, [&](int, int k) {
+        closest[k] = matcher.closest(unpackRgb(distinct.colors[k]).to_lab());
+    }, "lookup worker");
 
-            lookupTable[j][i] = texIdx;
+    process2dInParallel(bitmap.m_height, 1, [&](int, int j) {
+        uchar const* px = &bitmap.m_bits[Bitmap::CHANNELS * j * bitmap.m_width];
+        for (int i = 0; i < bitmap.m_width; i++, px += Bitmap::CHANNELS) {
+            lookupTable[j][i] = closest[distinct.indexOf(packRgb(px))];
         }
-    }
+    }, "scatter worker");
 
     return lookupTable;
 }
@@ -0,0 +1,522 @@
+// End-to-end regression test of the mosaic, quantize and atlas paths.
+//
+// Fixed synthetic inputs, and the atlas of the real textures, are rendered with
+// the default settings and compared to the lookup tables and images in
+// test/golden. An optimization may move a few colors across a decision
+// boundary, so up to --tolerance of the lookup entries or pixels may differ;
+// a pixel differs when one of its channels is off by more than
+// CHANNEL_TOLERANCE.
+//
+// Then every stage is timed on a larger synthetic photo and compared to the
+// times stored in --perf-baseline. A stage more than --max-regression percent
+// slower fails the test. A missing baseline is written instead, so keep one
+// per machine and build flavor; make test keeps it in the build directory.
+//
+//   regressionTest [--update-goldens] [--perf-baseline <file>] [--update-baseline]
+//                  [--max-regression <percent>] [--tolerance <fraction>] [--skip-perf]
+//
+// Run from the repository root so ./blocks and ./test/golden can be found.
+
+#include "../bench/benchUtil.h"
+#include "../include/Bitmap.h"
+#include "../include/atlasPic.h"
+#include "../include/mosaicConfig.h"
+#include "../include/picture.h"
+#include "../include/pngDecoder.h"
+#include "../include/quantizePic.h"
+#include "../include/texturePic.h"
+#include "../include/util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+std::string const GOLDEN_DIR = "./test/golden";
+int constexpr CHANNEL_TOLERANCE = 8;
+int constexpr PERF_RUNS = 3;
+int constexpr PERF_WIDTH = 2048;
+int constexpr PERF_HEIGHT = 1536;
+
+struct Options {
+    bool updateGoldens = false;
+    bool updateBaseline = false;
+    bool skipPerf = false;
+    double maxRegressionPercent = 25;
+    double tolerance = 0.02;
+    std::string perfBaselinePath = "./build/perf_baseline.txt";
+};
+
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<uchar> rgb;
+};
+
+using LookupTable = std::vector<std::vector<int>>;
+
+// the kind of smooth photo the mosaic is made for, a shrunk one so the 512x384
+// checks still span several turns of the gradient
+Picture makeGradient(int width, int height)
+{
+    return makeSyntheticPicture(width, height, 1.6f, 0);
+}
+
+// hard-edged random patches with per-pixel noise, the worst case for the blur
+// and the closest-color search
+Picture makePatches(int width, int height)
+{
+    Picture pic(width, height);
+    unsigned seed = 7;
+    auto next = [&] {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    int constexpr PATCH = 24;
+    std::vector<int> colors;
+    for (int i = 0; i < 3 * ((width / PATCH + 1) * (height / PATCH + 1)); ++i) {
+        colors.push_back(next() % 256);
+    }
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int const patch = 3 * ((y / PATCH) * (width / PATCH + 1) + x / PATCH);
+            int const noise = static_cast<int>(next() % 17) - 8;
+            pic.set(x, y, std::clamp(colors[patch] + noise, 0, 255),
+                std::clamp(colors[patch + 1] + noise, 0, 255),
+                std::clamp(colors[patch + 2] + noise, 0, 255));
+        }
+    }
+
+    return pic;
+}
+
+Image readImage(std::string const& path)
+{
+    Image image;
+    decodePng(path, image.rgb, image.width, image.height, 3);
+    return image;
+}
+
+// keeps one pixel of every factor x factor square, undoing a nearest-neighbor
+// zoom
+Image shrink(Image const& image, int factor)
+{
+    Image small { image.width / factor, image.height / factor, {} };
+
+    for (int y = 0; y < small.height; ++y) {
+        for (int x = 0; x < small.width; ++x) {
+            size_t const offset = 3 * (static_cast<size_t>(y) * factor * image.width + x * factor);
+            small.rgb.insert(small.rgb.end(), &image.rgb[offset], &image.rgb[offset + 3]);
+        }
+    }
+
+    return small;
+}
+
+Picture toPicture(Image const& image)
+{
+    Picture pic(image.width, image.height);
+
+    for (int y = 0; y < image.height; ++y) {
+        for (int x = 0; x < image.width; ++x) {
+            uchar const* px = &image.rgb[3 * (static_cast<size_t>(y) * image.width + x)];
+            pic.set(x, y, px[0], px[1], px[2]);
+        }
+    }
+
+    return pic;
+}
+
+void writeLookupTable(std::string const& path, LookupTable const& table)
+{
+    std::ofstream ofs(path);
+    ofs << (table.empty() ? 0 : table[0].size()) << ' ' << table.size() << '\n';
+
+    for (auto const& row : table) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            ofs << (i ? " " : "") << row[i];
+        }
+        ofs << '\n';
+    }
+
+    if (!ofs)
+        throw std::runtime_error("failed to write " + path);
+}
+
+LookupTable readLookupTable(std::string const& path)
+{
+    std::ifstream ifs(path);
+    size_t width = 0, height = 0;
+    if (!(ifs >> width >> height))
+        throw std::runtime_error("missing or malformed golden: " + path);
+
+    LookupTable table(height, std::vector<int>(width));
+    for (auto& row : table) {
+        for (int& idx : row) {
+            ifs >> idx;
+        }
+    }
+
+    if (!ifs)
+        throw std::runtime_error("malformed golden: " + path);
+    return table;
+}
+
+class Checker {
+public:
+    explicit Checker(Options const& options)
+        : m_options(options)
+    {
+    }
+
+    void checkLookupTable(std::string const& name, LookupTable const& table)
+    {
+        std::string const path = GOLDEN_DIR + "/" + name + ".txt";
+        if (m_options.updateGoldens) {
+            fs::create_directories(fs::path(path).parent_path());
+            writeLookupTable(path, table);
+            report(name + " lookup", true, "golden written");
+            return;
+        }
+
+        LookupTable const golden = readLookupTable(path);
+        bool const sameSize = golden.size() == table.size()
+            && (golden.empty() || golden[0].size() == table[0].size());
+        if (!sameSize) {
+            report(name + " lookup", false, "size changed");
+            return;
+        }
+
+        size_t differing = 0, total = 0;
+        for (size_t j = 0; j < golden.size(); ++j) {
+            for (size_t i = 0; i < golden[j].size(); ++i) {
+                differing += golden[j][i] != table[j][i];
+                ++total;
+            }
+        }
+
+        reportFraction(name + " lookup", differing, total, "entries");
+    }
+
+    // golden images are stored shrunk by zoom when the output is zoomed
+    void checkImage(std::string const& name, std::string const& outputPath, int zoom = 1)
+    {
+        std::string const path = GOLDEN_DIR + "/" + name + ".png";
+        if (m_options.updateGoldens) {
+            fs::create_directories(fs::path(path).parent_path());
+            if (zoom == 1) {
+                fs::copy_file(outputPath, path, fs::copy_options::overwrite_existing);
+            } else {
+                toPicture(shrink(readImage(outputPath), zoom)).save(path);
+            }
+            report(name + " image", true, "golden written");
+            return;
+        }
+
+        Image const golden = readImage(path);
+        Image const output
+            = zoom == 1 ? readImage(outputPath) : shrink(readImage(outputPath), zoom);
+        if (golden.width != output.width || golden.height != output.height) {
+            report(name + " image", false, "size changed");
+            return;
+        }
+
+        size_t differing = 0;
+        for (size_t p = 0; p < golden.rgb.size(); p += 3) {
+            for (int c = 0; c < 3; ++c) {
+                if (std::abs(golden.rgb[p + c] - output.rgb[p + c]) > CHANNEL_TOLERANCE) {
+                    ++differing;
+                    break;
+                }
+            }
+        }
+
+        reportFraction(name + " image", differing, golden.rgb.size() / 3, "pixels");
+    }
+
+    void report(std::string const& name, bool passed, std::string const& detail)
+    {
+        std::printf("%s  %-40s %s\n", passed ? "PASS" : "FAIL", name.c_str(), detail.c_str());
+        m_failures += !passed;
+    }
+
+    int failures() const { return m_failures; }
+
+private:
+    void reportFraction(std::string const& name, size_t differing, size_t total, char const* what)
+    {
+        double const fraction = total ? static_cast<double>(differing) / total : 0;
+        char detail[96];
+        std::snprintf(detail, sizeof(detail), "%zu of %zu %s differ (%.2f%%)", differing, total,
+            what, fraction * 100);
+        report(name, fraction <= m_options.tolerance, detail);
+    }
+
+    Options m_options;
+    int m_failures = 0;
+};
+
+std::string outputPath(std::string const& name)
+{
+    std::string fileName = name;
+    std::replace(fileName.begin(), fileName.end(), '/', '_');
+    return (fs::temp_directory_path() / ("regressionTest_" + fileName + ".png")).string();
+}
+
+void checkMosaic(Checker& checker, std::string const& name, Picture pic,
+    std::vector<Bitmap> const& validTextures, std::vector<clrspc::Lab> const& textureAvgColors,
+    MosaicConfig const& config)
+{
+    LookupTable const table = buildTextureLookupTable(pic, textureAvgColors, config);
+    checker.checkLookupTable(name, table);
+
+    std::string const path = outputPath(name);
+    createTexturedPic(table, validTextures, path, OutputFormat::Png, config.blockSize);
+    checker.checkImage(name, path);
+    fs::remove(path);
+}
+
+void checkQuantized(Checker& checker, std::string const& name, Picture pic,
+    MosaicConfig const& config)
+{
+    pic.gaussianBlur(config.blurRadius);
+    Bitmap const bitmap = pic.bilinearResize(config.effectiveResizeFactor()).getBitmap();
+
+    std::string const path = outputPath(name);
+    createQuantizedPic(bitmap, config, path);
+    checker.checkImage(name, path);
+    fs::remove(path);
+}
+
+std::vector<std::pair<std::string, double>> measureStages(std::vector<Bitmap> const& validTextures,
+    std::vector<clrspc::Lab> const& textureAvgColors, MosaicConfig const& config)
+{
+    std::vector<std::pair<std::string, double>> stages;
+    std::string const inputPath = outputPath("perf_input");
+    std::string const resultPath = outputPath("perf_output");
+
+    makeGradient(PERF_WIDTH, PERF_HEIGHT).save(inputPath);
+
+    std::optional<Picture> pic;
+    stages.emplace_back("decode", bestOfMs(PERF_RUNS, [&] { pic.emplace(inputPath); }));
+
+    Picture blurred = *pic;
+    stages.emplace_back("blur", bestOfMs(PERF_RUNS, [&] {
+        blurred = *pic;
+        blurred.gaussianBlur(config.blurRadius);
+    }));
+
+    std::optional<Picture> minPic;
+    stages.emplace_back("resize", bestOfMs(PERF_RUNS, [&] {
+        minPic.emplace(blurred.bilinearResize(config.effectiveResizeFactor()));
+    }));
+
+    Bitmap bitmap(0, 0);
+    stages.emplace_back("bitmap", bestOfMs(PERF_RUNS, [&] { bitmap = minPic->getBitmap(); }));
+
+    LookupTable table;
+    stages.emplace_back(
+        "lookup", bestOfMs(PERF_RUNS, [&] { table = buildLookupTable(bitmap, textureAvgColors); }));
+
+    stages.emplace_back("compose+encode", bestOfMs(PERF_RUNS, [&] {
+        createTexturedPic(table, validTextures, resultPath, OutputFormat::Png, config.blockSize);
+    }));
+
+    stages.emplace_back(
+        "quantize", bestOfMs(PERF_RUNS, [&] { createQuantizedPic(bitmap, config, resultPath); }));
+
+    stages.emplace_back("atlas", bestOfMs(PERF_RUNS, [&] {
+        createAtlasPic(validTextures, config.blockSize, resultPath);
+    }));
+
+    fs::remove(inputPath);
+    fs::remove(resultPath);
+    return stages;
+}
+
+std::map<std::string, double> readBaseline(std::string const& path)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream ifs(path);
+    std::string stage;
+    double ms;
+
+    while (ifs >> stage >> ms) {
+        baseline[stage] = ms;
+    }
+
+    return baseline;
+}
+
+void writeBaseline(
+    std::string const& path, std::vector<std::pair<std::string, double>> const& stages)
+{
+    if (fs::path(path).has_parent_path()) {
+        fs::create_directories(fs::path(path).parent_path());
+    }
+
+    std::ofstream ofs(path);
+    for (auto const& [stage, ms] : stages) {
+        ofs << stage << ' ' << ms << '\n';
+    }
+
+    if (!ofs)
+        throw std::runtime_error("failed to write " + path);
+}
+
+void checkPerformance(Checker& checker, Options const& options,
+    std::vector<Bitmap> const& validTextures, std::vector<clrspc::Lab> const& textureAvgColors,
+    MosaicConfig const& config)
+{
+    auto const stages = measureStages(validTextures, textureAvgColors, config);
+    std::map<std::string, double> const baseline = readBaseline(options.perfBaselinePath);
+
+    if (baseline.empty() || options.updateBaseline) {
+        writeBaseline(options.perfBaselinePath, stages);
+        for (auto const& [stage, ms] : stages) {
+            char detail[64];
+            std::snprintf(detail, sizeof(detail), "%.2f ms, baseline written", ms);
+            checker.report("perf/" + stage, true, detail);
+        }
+        return;
+    }
+
+    for (auto const& [stage, ms] : stages) {
+        auto const found = baseline.find(stage);
+        if (found == baseline.end()) {
+            checker.report("perf/" + stage, true, "not in baseline");
+            continue;
+        }
+
+        double const change = (ms / found->second - 1) * 100;
+        char detail[96];
+        std::snprintf(detail, sizeof(detail), "%.2f ms vs %.2f ms baseline (%+.1f%%)", ms,
+            found->second, change);
+        checker.report("perf/" + stage, change <= options.maxRegressionPercent, detail);
+    }
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string const arg = argv[i];
+
+        if (arg == "--update-goldens") {
+            options.updateGoldens = true;
+            continue;
+        }
+        if (arg == "--update-baseline") {
+            options.updateBaseline = true;
+            continue;
+        }
+        if (arg == "--skip-perf") {
+            options.skipPerf = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+            throw std::invalid_argument("missing value for " + arg);
+
+        std::string const value = argv[++i];
+        if (arg == "--perf-baseline") {
+            options.perfBaselinePath = value;
+        } else if (arg == "--max-regression") {
+            options.maxRegressionPercent = std::stod(value);
+        } else if (arg == "--tolerance") {
+            options.tolerance = std::stod(value);
+        } else {
+            throw std::invalid_argument("unknown option: " + arg);
+        }
+    }
+
+    return options;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (std::exception const& e) {
+        std::cerr << e.what()
+                  << "\nusage: regressionTest [--update-goldens] [--perf-baseline <file>] "
+                     "[--update-baseline]\n"
+                     "                      [--max-regression <percent>] [--tolerance "
+                     "<fraction>] [--skip-perf]\n";
+        return 1;
+    }
+
+    Checker checker(options);
+
+    try {
+        // a fresh cache in the temp directory, so the usable textures are always
+        // recomputed and the checked-in ./texture.dat is never rewritten
+        MosaicConfig config;
+        config.textureCachePath =
+            (fs::temp_directory_path() / "regressionTest_texture.dat").string();
+        fs::remove(config.textureCachePath);
+
+        std::vector<Bitmap> validTextures;
+        std::vector<clrspc::Lab> textureAvgColors;
+        getTextureData(validTextures, textureAvgColors, config);
+        fs::remove(config.textureCachePath);
+
+        checkMosaic(checker, "mosaic/gradient", makeGradient(512, 384), validTextures,
+            textureAvgColors, config);
+        checkMosaic(checker, "mosaic/patches", makePatches(512, 384), validTextures,
+            textureAvgColors, config);
+
+        // the textures themselves are the real-world input, at their own size
+        std::string const atlasPath = outputPath("atlas");
+        createAtlasPic(validTextures, config.blockSize, atlasPath);
+        checker.checkImage("atlas", atlasPath, atlasZoom(config.blockSize));
+        checkMosaic(checker, "mosaic/atlas",
+            toPicture(shrink(readImage(atlasPath), atlasZoom(config.blockSize))),
+            validTextures, textureAvgColors, config);
+        fs::remove(atlasPath);
+
+        checkQuantized(checker, "quantize/gradient", makeGradient(512, 384), config);
+        checkQuantized(checker, "quantize/patches", makePatches(512, 384), config);
+
+        MosaicConfig dithered = config;
+        dithered.dither = DitherMethod::FloydSteinberg;
+        checkMosaic(checker, "mosaic/gradient_floyd_steinberg", makeGradient(512, 384),
+            validTextures, textureAvgColors, dithered);
+        dithered.dither = DitherMethod::Jarvis;
+        checkQuantized(checker, "quantize/gradient_jarvis", makeGradient(512, 384), dithered);
+        dithered.dither = DitherMethod::BlueNoise;
+        checkQuantized(checker, "quantize/gradient_blue_noise", makeGradient(512, 384), dithered);
+
+        MosaicConfig perceptual = config;
+        perceptual.metric = ColorMetric::Ciede2000;
+        checkMosaic(checker, "mosaic/gradient_ciede2000", makeGradient(512, 384), validTextures,
+            textureAvgColors, perceptual);
+
+        MosaicConfig adaptive = config;
+        adaptive.paletteSize = 16;
+        checkQuantized(checker, "quantize/patches_palette16", makePatches(512, 384), adaptive);
+
+        if (!options.skipPerf) {
+            checkPerformance(checker, options, validTextures, textureAvgColors, config);
+        }
+    } catch (std::exception const& e) {
+        checker.report("error", false, e.what());
+    }
+
+    std::printf("%d failure%s\n", checker.failures(), checker.failures() == 1 ? "" : "s");
+    return checker.failures() == 0 ? 0 : 1;
+}